@@ -0,0 +1,466 @@
+#include "FakeS3Server.hpp"
+#include "stl2glb/Logger.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+
+namespace stl2glb {
+
+    namespace {
+        // Blocco massimo scritto a ogni chiamata del content provider
+        constexpr size_t SEND_BLOCK_SIZE = 64 * 1024;
+
+        // Oltre questa finestra lo slow start è concluso e vale solo la banda
+        constexpr uint64_t SLOW_START_LIMIT = 1ull << 30;
+
+        // Connessioni ricordate prima di dimenticare quelle inattive
+        constexpr size_t MAX_TRACKED_CONNECTIONS = 4096;
+        constexpr std::chrono::minutes CONNECTION_IDLE{5};
+
+        const char* const OBJECT_PATTERN = R"(/[^/-][^/]*/.+)";
+        const char* const BUCKET_PATTERN = R"(/[^/-][^/]*/?)";
+
+        // Chiave "<bucket>/<nome>" dal path della richiesta
+        std::string objectKey(const httplib::Request& req) {
+            return req.path.substr(1);
+        }
+
+        // Contenuto del primo elemento <tag> a partire da position, che avanza oltre la chiusura
+        std::string xmlElement(const std::string& xml, const std::string& tag, size_t& position) {
+            const std::string open = "<" + tag + ">";
+            const std::string close = "</" + tag + ">";
+            size_t start = xml.find(open, position);
+            if (start == std::string::npos) {
+                position = std::string::npos;
+                return "";
+            }
+            start += open.size();
+            size_t end = xml.find(close, start);
+            if (end == std::string::npos) {
+                position = std::string::npos;
+                return "";
+            }
+            position = end + close.size();
+            return xml.substr(start, end - start);
+        }
+
+        // ETag di una parte: ricalcolabile al complete senza conservarlo
+        std::string partEtag(const std::string& uploadId, unsigned int partNumber) {
+            return "\"" + uploadId + "-" + std::to_string(partNumber) + "\"";
+        }
+
+        bool optionValue(const std::string& arg, const char* name, std::string& value) {
+            std::string prefix = std::string("--") + name + "=";
+            if (arg.compare(0, prefix.size(), prefix) != 0) return false;
+            value = arg.substr(prefix.size());
+            return true;
+        }
+
+        double parseNumber(const std::string& arg, const std::string& value) {
+            char* end = nullptr;
+            double parsed = std::strtod(value.c_str(), &end);
+            if (value.empty() || *end != '\0' || parsed < 0) {
+                throw std::runtime_error("Invalid option: " + arg);
+            }
+            return parsed;
+        }
+    }
+
+    bool FakeS3Config::parseOption(const std::string& arg) {
+        std::string value;
+        if (optionValue(arg, "latency-ms", value)) {
+            latency = std::chrono::milliseconds(static_cast<long long>(parseNumber(arg, value)));
+        } else if (optionValue(arg, "bandwidth-mb-per-s", value)) {
+            bandwidth_bytes_per_second = static_cast<uint64_t>(parseNumber(arg, value) * 1024 * 1024);
+        } else if (optionValue(arg, "error-rate", value)) {
+            error_rate = parseNumber(arg, value);
+        } else if (optionValue(arg, "reset-rate", value)) {
+            reset_rate = parseNumber(arg, value);
+        } else if (optionValue(arg, "slow-start-kb", value)) {
+            slow_start_window_bytes = static_cast<uint64_t>(parseNumber(arg, value) * 1024);
+        } else if (optionValue(arg, "slow-start-rtt-ms", value)) {
+            slow_start_rtt = std::chrono::milliseconds(static_cast<long long>(parseNumber(arg, value)));
+        } else if (optionValue(arg, "threads", value)) {
+            threads = std::max(1u, static_cast<unsigned int>(parseNumber(arg, value)));
+        } else if (optionValue(arg, "seed", value)) {
+            seed = static_cast<uint32_t>(parseNumber(arg, value));
+        } else {
+            return false;
+        }
+        if (error_rate > 1.0 || reset_rate > 1.0) {
+            throw std::runtime_error("Invalid option: " + arg + " (rates are between 0 and 1)");
+        }
+        return true;
+    }
+
+    FakeS3Server::Throttle::Throttle(const FakeS3Config& config, Connection& connection)
+            : config(config), connection(connection), deadline(std::chrono::steady_clock::now()) {}
+
+    void FakeS3Server::Throttle::transfer(size_t bytes) {
+        double rate = static_cast<double>(config.bandwidth_bytes_per_second);
+
+        // Durante lo slow start passa al più una finestra per RTT; ogni finestra
+        // completata la raddoppia
+        if (connection.window > 0 && connection.window < SLOW_START_LIMIT && config.slow_start_rtt.count() > 0) {
+            double windowRate = connection.window * 1000.0 / config.slow_start_rtt.count();
+            rate = rate > 0 ? std::min(rate, windowRate) : windowRate;
+
+            connection.sentInWindow += bytes;
+            while (connection.sentInWindow >= connection.window && connection.window < SLOW_START_LIMIT) {
+                connection.sentInWindow -= connection.window;
+                connection.window *= 2;
+            }
+        }
+
+        if (rate <= 0) return;
+        deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(bytes / rate));
+        std::this_thread::sleep_until(deadline);
+    }
+
+    FakeS3Server::FakeS3Server(FakeS3Config config) : config(config), rng(config.seed) {
+        unsigned int threads = config.threads;
+        server.new_task_queue = [threads] { return new httplib::ThreadPool(threads); };
+
+        // Come MinIO: le connessioni restano aperte, così il pool del client viene misurato davvero
+        server.set_keep_alive_max_count(1000000);
+        server.set_keep_alive_timeout(60);
+
+        routes();
+    }
+
+    FakeS3Server::~FakeS3Server() {
+        stop();
+    }
+
+    int FakeS3Server::start(const std::string& host, int port) {
+        int bound = port;
+        if (port == 0) {
+            bound = server.bind_to_any_port(host);
+        } else if (!server.bind_to_port(host, port)) {
+            bound = -1;
+        }
+        if (bound < 0) {
+            throw std::runtime_error("FakeS3Server cannot bind to " + host + ":" + std::to_string(port));
+        }
+
+        thread = std::thread([this] { server.listen_after_bind(); });
+        Logger::info("FakeS3Server listening on " + host + ":" + std::to_string(bound));
+        return bound;
+    }
+
+    void FakeS3Server::listen(const std::string& host, int port) {
+        Logger::info("FakeS3Server listening on " + host + ":" + std::to_string(port));
+        if (!server.listen(host, port)) {
+            throw std::runtime_error("FakeS3Server cannot listen on " + host + ":" + std::to_string(port));
+        }
+    }
+
+    void FakeS3Server::stop() {
+        server.stop();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    void FakeS3Server::putObject(const std::string& bucket, const std::string& objectName, std::string content) {
+        auto object = std::make_shared<const std::string>(std::move(content));
+        std::lock_guard<std::mutex> lock(mutex);
+        objects[bucket + "/" + objectName] = std::move(object);
+    }
+
+    FakeS3Stats FakeS3Server::stats() const {
+        FakeS3Stats stats;
+        stats.requests = counters.requests;
+        stats.connections = counters.connections;
+        stats.gets = counters.gets;
+        stats.heads = counters.heads;
+        stats.puts = counters.puts;
+        stats.posts = counters.posts;
+        stats.deletes = counters.deletes;
+        stats.bytesSent = counters.bytesSent;
+        stats.bytesReceived = counters.bytesReceived;
+        stats.injectedErrors = counters.injectedErrors;
+        stats.injectedResets = counters.injectedResets;
+        return stats;
+    }
+
+    void FakeS3Server::routes() {
+        server.Get("/-/stats", [this](const httplib::Request&, httplib::Response& res) {
+            auto s = stats();
+            nlohmann::json body = {
+                    {"requests", s.requests},
+                    {"connections", s.connections},
+                    {"gets", s.gets},
+                    {"heads", s.heads},
+                    {"puts", s.puts},
+                    {"posts", s.posts},
+                    {"deletes", s.deletes},
+                    {"bytes_sent", s.bytesSent},
+                    {"bytes_received", s.bytesReceived},
+                    {"injected_errors", s.injectedErrors},
+                    {"injected_resets", s.injectedResets}
+            };
+            res.set_content(body.dump(), "application/json");
+        });
+
+        server.Get(OBJECT_PATTERN, [this](const httplib::Request& req, httplib::Response& res) {
+            handleGet(req, res);
+        });
+        server.Put(OBJECT_PATTERN, [this](const httplib::Request& req, httplib::Response& res,
+                                          const httplib::ContentReader& reader) {
+            handlePut(req, res, reader);
+        });
+        server.Post(OBJECT_PATTERN, [this](const httplib::Request& req, httplib::Response& res) {
+            handlePost(req, res);
+        });
+        server.Delete(OBJECT_PATTERN, [this](const httplib::Request& req, httplib::Response& res) {
+            handleDelete(req, res);
+        });
+
+        // Bucket: esistono tutti e la creazione riesce sempre
+        auto bucket = [this](const httplib::Request& req, httplib::Response& res) {
+            connection(req);
+            if (admit(res)) res.status = 200;
+        };
+        server.Get(BUCKET_PATTERN, bucket);
+        server.Put(BUCKET_PATTERN, bucket);
+    }
+
+    std::shared_ptr<FakeS3Server::Connection> FakeS3Server::connection(const httplib::Request& req) {
+        const std::string key = req.remote_addr + ":" + std::to_string(req.remote_port);
+        const auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& entry = connections[key];
+        if (!entry) {
+            ++counters.connections;
+            entry = std::make_shared<Connection>();
+            entry->window = config.slow_start_window_bytes;
+
+            if (connections.size() > MAX_TRACKED_CONNECTIONS) {
+                for (auto it = connections.begin(); it != connections.end();) {
+                    bool idle = it->second.use_count() == 1 && now - it->second->lastSeen > CONNECTION_IDLE;
+                    it = idle ? connections.erase(it) : std::next(it);
+                }
+            }
+        }
+        entry->lastSeen = now;
+        return entry;
+    }
+
+    bool FakeS3Server::chance(double probability) {
+        if (probability <= 0.0) return false;
+        std::lock_guard<std::mutex> lock(rngMutex);
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng) < probability;
+    }
+
+    bool FakeS3Server::admit(httplib::Response& res) {
+        ++counters.requests;
+
+        if (config.latency.count() > 0) {
+            std::this_thread::sleep_for(config.latency);
+        }
+        if (chance(config.error_rate)) {
+            ++counters.injectedErrors;
+            error(res, 503, "SlowDown");
+            return false;
+        }
+        return true;
+    }
+
+    void FakeS3Server::error(httplib::Response& res, int status, const std::string& code) {
+        res.status = status;
+        res.set_content("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<Error><Code>" + code +
+                        "</Code><Message>" + code + "</Message></Error>", "application/xml");
+    }
+
+    FakeS3Server::Object FakeS3Server::find(const std::string& key) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = objects.find(key);
+        return it == objects.end() ? nullptr : it->second;
+    }
+
+    void FakeS3Server::handleGet(const httplib::Request& req, httplib::Response& res) {
+        const bool head = req.method == "HEAD";
+        ++(head ? counters.heads : counters.gets);
+        auto conn = connection(req);
+        if (!admit(res)) return;
+
+        Object object = find(objectKey(req));
+        if (!object) {
+            error(res, 404, "NoSuchKey");
+            return;
+        }
+
+        res.set_header("Accept-Ranges", "bytes");
+        res.set_header("ETag", "\"" + std::to_string(object->size()) + "\"");
+
+        // Intervalli (Range) e HEAD sono gestiti da httplib sul provider dell'intero oggetto
+        struct Progress {
+            size_t limit = 0;
+            size_t sent = 0;
+        };
+        auto progress = std::make_shared<Progress>();
+        const bool reset = !head && chance(config.reset_rate);
+        auto throttle = std::make_shared<Throttle>(config, *conn);
+
+        res.set_content_provider(
+                object->size(), "application/octet-stream",
+                [this, object, conn, throttle, progress, reset](size_t offset, size_t length, httplib::DataSink& sink) {
+                    // Con reset la risposta si interrompe a metà del corpo richiesto
+                    if (progress->limit == 0) {
+                        progress->limit = reset ? length / 2 : length;
+                    }
+                    if (reset && progress->sent >= progress->limit) {
+                        ++counters.injectedResets;
+                        return false;
+                    }
+
+                    size_t chunk = std::min(length, SEND_BLOCK_SIZE);
+                    throttle->transfer(chunk);
+                    if (!sink.write(object->data() + offset, chunk)) {
+                        return false;
+                    }
+                    progress->sent += chunk;
+                    counters.bytesSent += chunk;
+                    return true;
+                });
+    }
+
+    void FakeS3Server::handlePut(const httplib::Request& req, httplib::Response& res,
+                                 const httplib::ContentReader& reader) {
+        ++counters.puts;
+        auto conn = connection(req);
+        const bool accepted = admit(res);
+
+        // Il corpo viene letto anche quando la richiesta è respinta: la connessione resta utilizzabile
+        Throttle throttle(config, *conn);
+        std::string body;
+        if (accepted && req.has_header("Content-Length")) {
+            body.reserve(std::strtoull(req.get_header_value("Content-Length").c_str(), nullptr, 10));
+        }
+        reader([&](const char* data, size_t length) {
+            throttle.transfer(length);
+            counters.bytesReceived += length;
+            if (accepted) body.append(data, length);
+            return true;
+        });
+        if (!accepted) return;
+
+        const std::string key = objectKey(req);
+        if (!req.has_param("uploadId")) {
+            res.set_header("ETag", "\"" + std::to_string(body.size()) + "\"");
+            putObject(key.substr(0, key.find('/')), key.substr(key.find('/') + 1), std::move(body));
+            res.status = 200;
+            return;
+        }
+
+        const std::string uploadId = req.get_param_value("uploadId");
+        const unsigned long partNumber = std::strtoul(req.get_param_value("partNumber").c_str(), nullptr, 10);
+        if (partNumber < 1 || partNumber > 10000) {
+            error(res, 400, "InvalidArgument");
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = uploads.find(uploadId);
+        if (it == uploads.end() || it->second.key != key) {
+            error(res, 404, "NoSuchUpload");
+            return;
+        }
+        it->second.parts[static_cast<unsigned int>(partNumber)] = std::make_shared<const std::string>(std::move(body));
+        res.set_header("ETag", partEtag(uploadId, static_cast<unsigned int>(partNumber)));
+        res.status = 200;
+    }
+
+    void FakeS3Server::handlePost(const httplib::Request& req, httplib::Response& res) {
+        ++counters.posts;
+        connection(req);
+        if (!admit(res)) return;
+
+        const std::string key = objectKey(req);
+        if (req.has_param("uploads")) {
+            std::string uploadId;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                uploadId = "fake-" + std::to_string(nextUploadId++);
+                uploads[uploadId].key = key;
+            }
+            res.set_content("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<InitiateMultipartUploadResult><UploadId>" +
+                            uploadId + "</UploadId></InitiateMultipartUploadResult>", "application/xml");
+            return;
+        }
+
+        if (!req.has_param("uploadId")) {
+            error(res, 400, "InvalidRequest");
+            return;
+        }
+
+        // Le parti elencate, in ordine crescente e con l'ETag restituito, formano l'oggetto
+        const std::string uploadId = req.get_param_value("uploadId");
+        std::string content;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = uploads.find(uploadId);
+            if (it == uploads.end() || it->second.key != key) {
+                error(res, 404, "NoSuchUpload");
+                return;
+            }
+
+            unsigned int previous = 0;
+            for (size_t position = 0;;) {
+                std::string part = xmlElement(req.body, "Part", position);
+                if (position == std::string::npos) break;
+
+                size_t inner = 0;
+                unsigned int number = static_cast<unsigned int>(
+                        std::strtoul(xmlElement(part, "PartNumber", inner).c_str(), nullptr, 10));
+                inner = 0;
+                std::string etag = xmlElement(part, "ETag", inner);
+
+                auto found = it->second.parts.find(number);
+                if (number <= previous) {
+                    error(res, 400, "InvalidPartOrder");
+                    return;
+                }
+                if (found == it->second.parts.end() || etag != partEtag(uploadId, number)) {
+                    error(res, 400, "InvalidPart");
+                    return;
+                }
+                content += *found->second;
+                previous = number;
+            }
+            if (previous == 0) {
+                error(res, 400, "MalformedXML");
+                return;
+            }
+            uploads.erase(it);
+        }
+
+        std::string etag = "\"" + std::to_string(content.size()) + "\"";
+        putObject(key.substr(0, key.find('/')), key.substr(key.find('/') + 1), std::move(content));
+        res.set_content("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<CompleteMultipartUploadResult><ETag>" +
+                        etag + "</ETag></CompleteMultipartUploadResult>", "application/xml");
+    }
+
+    void FakeS3Server::handleDelete(const httplib::Request& req, httplib::Response& res) {
+        ++counters.deletes;
+        connection(req);
+        if (!admit(res)) return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (req.has_param("uploadId")) {
+            if (uploads.erase(req.get_param_value("uploadId")) == 0) {
+                error(res, 404, "NoSuchUpload");
+                return;
+            }
+        } else {
+            objects.erase(objectKey(req));
+        }
+        res.status = 204;
+    }
+
+} // namespace stl2glb
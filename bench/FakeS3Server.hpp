@@ -0,0 +1,171 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <httplib.h>
+
+namespace stl2glb {
+
+/**
+ * @struct FakeS3Config
+ * @brief Guasti e limiti simulati da FakeS3Server
+ */
+    struct FakeS3Config {
+        // Attesa prima di ogni risposta (tempo al primo byte)
+        std::chrono::milliseconds latency{0};
+
+        // Banda per connessione in byte/s, in entrambe le direzioni; 0 = illimitata
+        uint64_t bandwidth_bytes_per_second = 0;
+
+        // Probabilità che una richiesta riceva 503 SlowDown invece della risposta
+        double error_rate = 0.0;
+
+        // Probabilità che il corpo di una GET venga interrotto a metà (connessione chiusa)
+        double reset_rate = 0.0;
+
+        // Slow start per connessione: la prima finestra è di slow_start_window_bytes
+        // (0 disabilita) e raddoppia a ogni slow_start_rtt; la finestra raggiunta resta
+        // alla connessione keep-alive, quindi una connessione riusata non riparte da capo
+        uint64_t slow_start_window_bytes = 0;
+        std::chrono::milliseconds slow_start_rtt{50};
+
+        // Thread del server HTTP (richieste servite in parallelo)
+        unsigned int threads = 64;
+
+        uint32_t seed = 42;
+
+        // Riconosce "--latency-ms=", "--bandwidth-mb-per-s=", "--error-rate=", "--reset-rate=",
+        // "--slow-start-kb=", "--slow-start-rtt-ms=", "--threads=" e "--seed="; false per altri argomenti
+        bool parseOption(const std::string& arg);
+    };
+
+/**
+ * @struct FakeS3Stats
+ * @brief Contatori di FakeS3Server
+ */
+    struct FakeS3Stats {
+        uint64_t requests = 0;
+        uint64_t connections = 0;  // Connessioni distinte viste (remote_addr:remote_port)
+        uint64_t gets = 0;
+        uint64_t heads = 0;
+        uint64_t puts = 0;
+        uint64_t posts = 0;
+        uint64_t deletes = 0;
+        uint64_t bytesSent = 0;
+        uint64_t bytesReceived = 0;
+        uint64_t injectedErrors = 0;
+        uint64_t injectedResets = 0;
+    };
+
+/**
+ * @class FakeS3Server
+ * @brief Server S3 in memoria per benchmark e iniezione di guasti
+ *
+ * Implementa il sottoinsieme usato da SimpleMinioClient e AsyncS3Client:
+ * GET (anche con Range, gestito da httplib), HEAD, PUT di oggetti e bucket,
+ * upload multipart (initiate, parti, complete, abort). Le firme AWS V4 non
+ * vengono verificate. GET /-/stats restituisce i contatori in JSON (nessun
+ * bucket S3 valido inizia con "-").
+ */
+    class FakeS3Server {
+    public:
+        explicit FakeS3Server(FakeS3Config config = {});
+        ~FakeS3Server();
+
+        FakeS3Server(const FakeS3Server&) = delete;
+        FakeS3Server& operator=(const FakeS3Server&) = delete;
+
+        // Avvia il server su un thread proprio; con port 0 sceglie una porta libera.
+        // Restituisce la porta in ascolto
+        int start(const std::string& host = "127.0.0.1", int port = 0);
+
+        // Serve le richieste sul thread chiamante fino a stop()
+        void listen(const std::string& host, int port);
+
+        void stop();
+
+        // Carica un oggetto senza passare da HTTP (preparazione dei benchmark)
+        void putObject(const std::string& bucket, const std::string& objectName, std::string content);
+
+        FakeS3Stats stats() const;
+
+    private:
+        using Object = std::shared_ptr<const std::string>;
+
+        // Stato di una connessione keep-alive, usato solo dal thread che la serve
+        struct Connection {
+            uint64_t window = 0;
+            uint64_t sentInWindow = 0;
+            std::chrono::steady_clock::time_point lastSeen;
+        };
+
+        // Ritmo di invio o ricezione di un corpo secondo banda e finestra della connessione
+        class Throttle {
+        public:
+            Throttle(const FakeS3Config& config, Connection& connection);
+            // Attende il tempo necessario a trasferire altri bytes byte
+            void transfer(size_t bytes);
+
+        private:
+            const FakeS3Config& config;
+            Connection& connection;
+            std::chrono::steady_clock::time_point deadline;
+        };
+
+        struct MultipartUpload {
+            std::string key;
+            std::map<unsigned int, Object> parts;
+        };
+
+        void routes();
+        // Latenza ed eventuale errore iniettato (già scritto in res); true se la richiesta va servita
+        bool admit(httplib::Response& res);
+        // Stato della connessione da cui arriva la richiesta, creato alla prima richiesta
+        std::shared_ptr<Connection> connection(const httplib::Request& req);
+        bool chance(double probability);
+
+        // Richieste sugli oggetti (path "/<bucket>/<nome>"); HEAD passa da handleGet
+        void handleGet(const httplib::Request& req, httplib::Response& res);
+        void handlePut(const httplib::Request& req, httplib::Response& res, const httplib::ContentReader& reader);
+        void handlePost(const httplib::Request& req, httplib::Response& res);
+        void handleDelete(const httplib::Request& req, httplib::Response& res);
+
+        static void error(httplib::Response& res, int status, const std::string& code);
+        Object find(const std::string& key) const;
+
+        FakeS3Config config;
+        httplib::Server server;
+        std::thread thread;
+
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Object> objects;
+        std::unordered_map<std::string, MultipartUpload> uploads;
+        std::unordered_map<std::string, std::shared_ptr<Connection>> connections;
+        uint64_t nextUploadId = 1;
+
+        std::mutex rngMutex;
+        std::mt19937 rng;
+
+        struct Counters {
+            std::atomic<uint64_t> requests{0};
+            std::atomic<uint64_t> connections{0};
+            std::atomic<uint64_t> gets{0};
+            std::atomic<uint64_t> heads{0};
+            std::atomic<uint64_t> puts{0};
+            std::atomic<uint64_t> posts{0};
+            std::atomic<uint64_t> deletes{0};
+            std::atomic<uint64_t> bytesSent{0};
+            std::atomic<uint64_t> bytesReceived{0};
+            std::atomic<uint64_t> injectedErrors{0};
+            std::atomic<uint64_t> injectedResets{0};
+        } counters;
+    };
+
+} // namespace stl2glb
@@ -0,0 +1,90 @@
+// Benchmark della conversione completa (Converter::run) sul backend in memoria:
+// download, parse, saldatura, scrittura e hash del GLB, "upload", senza rete
+// né MinIO. Ogni iterazione riconverte lo stesso STL binario (sfera tassellata).
+//
+// Uso: bench_convert [numero_triangoli] [iterazioni] 2>/dev/null
+// I log di Converter vanno su stderr; i file temporanei restano in /tmp
+// solo durante ogni conversione.
+#include "stl2glb/Converter.hpp"
+#include "stl2glb/EnvironmentHandler.hpp"
+#include "stl2glb/StorageBackend.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // STL binario di una griglia deformata su una sfera (vertici interni condivisi da 6 triangoli)
+    std::string makeSphereStl(size_t targetTriangles) {
+        size_t side = static_cast<size_t>(std::sqrt(targetTriangles / 2.0)) + 1;
+        auto point = [&](size_t i, size_t j, float* p) {
+            double theta = M_PI * i / side;
+            double phi = 2.0 * M_PI * j / side;
+            p[0] = static_cast<float>(50.0 * std::sin(theta) * std::cos(phi));
+            p[1] = static_cast<float>(50.0 * std::sin(theta) * std::sin(phi));
+            p[2] = static_cast<float>(50.0 * std::cos(theta));
+        };
+
+        uint32_t count = static_cast<uint32_t>(side * side * 2);
+        std::string stl(80 + 4 + static_cast<size_t>(count) * 50, '\0');
+        std::memcpy(&stl[80], &count, 4);
+
+        char* out = &stl[84];
+        auto triangle = [&](size_t a0, size_t a1, size_t b0, size_t b1, size_t c0, size_t c1) {
+            float data[12] = {};
+            point(a0, a1, data + 3);
+            point(b0, b1, data + 6);
+            point(c0, c1, data + 9);
+            std::memcpy(out, data, sizeof(data));
+            out += 50;
+        };
+        for (size_t i = 0; i < side; ++i) {
+            for (size_t j = 0; j < side; ++j) {
+                triangle(i, j, i + 1, j, i + 1, j + 1);
+                triangle(i, j, i + 1, j + 1, i, j + 1);
+            }
+        }
+        return stl;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t triangles = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    setenv("STL2GLB_STORAGE", "memory", 1);
+    setenv("STL2GLB_STL_BUCKET_NAME", "stl", 0);
+    setenv("STL2GLB_GLB_BUCKET_NAME", "glb", 0);
+    auto& env = stl2glb::EnvironmentHandler::instance();
+    env.init();
+
+    std::string stl = makeSphereStl(triangles);
+    auto& storage = stl2glb::StorageBackend::instance();
+    storage.putText(env.getStlBucketName(), "bench", stl);
+
+    size_t count = (stl.size() - 84) / 50;
+    std::printf("%zu triangles, %.1f MB STL, backend %s\n", count, stl.size() / 1e6, storage.name());
+
+    double best = 0.0, total = 0.0;
+    std::string glb;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        glb = stl2glb::Converter::run("bench");
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = i == 0 ? ms : std::min(best, ms);
+        total += ms;
+        std::printf("iteration %d: %8.1f ms\n", i + 1, ms);
+    }
+
+    if (iterations > 0) {
+        std::printf("best %.1f ms, mean %.1f ms, %.1f Mtriangles/s, GLB %s\n", best, total / iterations,
+                    count / (best / 1000.0) / 1e6, glb.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+// Benchmark dell'hash SHA-256 dei file: implementazione precedente (ifstream
+// a blocchi da 4 KB) contro Hasher::sha256_file a blocchi da 4 MB, più
+// l'overload su buffer in memoria (sul file mappato), da 10 MB a 4 GB.
+// L'ultima colonna è Hasher::blake3_file (albero BLAKE3 su tutti i core).
+//
+// Uso: bench_hasher [directory_temporanea] [dimensione_massima_MB]
+// I file di prova vengono creati nella directory e rimossi alla fine;
+// la prima lettura di ogni file può includere l'I/O da disco.
+#include "stl2glb/Hasher.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+    // Implementazione precedente di Hasher::sha256_file, come riferimento
+    std::string legacySha256File(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        stl2glb::Sha256 hash;
+        char buffer[4096];
+        while (file.read(buffer, sizeof(buffer))) {
+            hash.update(buffer, file.gcount());
+        }
+        if (file.gcount() > 0) {
+            hash.update(buffer, file.gcount());
+        }
+        return hash.hexDigest();
+    }
+
+    void makeFile(const std::string& path, size_t size) {
+        std::vector<char> block(8 * 1024 * 1024);
+        std::mt19937 rng(42);
+        for (auto& c : block) c = static_cast<char>(rng());
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        for (size_t written = 0; written < size;) {
+            size_t n = std::min(block.size(), size - written);
+            out.write(block.data(), static_cast<std::streamsize>(n));
+            written += n;
+        }
+        if (!out) throw std::runtime_error("Cannot write " + path);
+    }
+
+    std::string hashMapped(const std::string& path, size_t size) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        madvise(data, size, MADV_SEQUENTIAL);
+        std::string hash = stl2glb::Hasher::sha256(data, size);
+        munmap(data, size);
+        ::close(fd);
+        return hash;
+    }
+
+    template <typename Fn>
+    double timeMs(Fn&& fn, std::string& out) {
+        auto start = std::chrono::steady_clock::now();
+        out = fn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    double gbPerSecond(size_t bytes, double ms) {
+        return bytes / (ms / 1000.0) / 1e9;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string dir = argc > 1 ? argv[1] : "/tmp";
+    size_t maxMb = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096;
+
+    std::printf("%10s %14s %14s %14s %14s\n", "size", "ifstream 4KB", "sha256_file", "sha256(buf)", "blake3_file");
+
+    bool consistent = true;
+    for (size_t mb : {10, 100, 1024, 4096}) {
+        if (mb > maxMb) break;
+
+        size_t size = mb * 1024 * 1024;
+        std::string path = dir + "/bench_hasher_" + std::to_string(mb) + ".bin";
+        makeFile(path, size);
+
+        std::string legacy, blocked, mapped, tree;
+        double legacyMs = timeMs([&] { return legacySha256File(path); }, legacy);
+        double blockedMs = timeMs([&] { return stl2glb::Hasher::sha256_file(path); }, blocked);
+        double mappedMs = timeMs([&] { return hashMapped(path, size); }, mapped);
+        double treeMs = timeMs([&] { return stl2glb::Hasher::blake3_file(path); }, tree);
+        std::remove(path.c_str());
+
+        consistent = consistent && legacy == blocked && legacy == mapped;
+        std::printf("%7zu MB %8.2f GB/s %8.2f GB/s %8.2f GB/s %8.2f GB/s %s\n", mb,
+                    gbPerSecond(size, legacyMs), gbPerSecond(size, blockedMs), gbPerSecond(size, mappedMs),
+                    gbPerSecond(size, treeMs),
+                    legacy == blocked && legacy == mapped ? "" : "MISMATCH");
+    }
+
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+// Benchmark end-to-end di /convert contro FakeS3Server: il servizio (Server)
+// e il server S3 finto girano nello stesso processo, un generatore di carico
+// invia richieste /convert da più connessioni e misura throughput e latenze.
+// Le opzioni di FakeS3Server simulano latenza, banda, errori, reset e slow
+// start, così pool di connessioni, ripetizioni e trasferimenti paralleli del
+// client si misurano senza un MinIO reale.
+//
+// Uso: bench_service [--requests=200] [--concurrency=8] [--objects=8]
+//      [--triangles=200000] [--port=18080] [opzioni di fake_s3_server] 2>/dev/null
+// La cache dei risultati è disabilitata (ogni richiesta converte) salvo
+// STL2GLB_RESULT_CACHE_SIZE nell'ambiente; le altre variabili STL2GLB_MINIO_*
+// già impostate vengono rispettate.
+#include "FakeS3Server.hpp"
+#include "stl2glb/EnvironmentHandler.hpp"
+#include "stl2glb/Server.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // STL binario di una griglia deformata su una sfera; il raggio rende diversi i GLB
+    std::string makeSphereStl(size_t targetTriangles, double radius) {
+        size_t side = static_cast<size_t>(std::sqrt(targetTriangles / 2.0)) + 1;
+        auto point = [&](size_t i, size_t j, float* p) {
+            double theta = M_PI * i / side;
+            double phi = 2.0 * M_PI * j / side;
+            p[0] = static_cast<float>(radius * std::sin(theta) * std::cos(phi));
+            p[1] = static_cast<float>(radius * std::sin(theta) * std::sin(phi));
+            p[2] = static_cast<float>(radius * std::cos(theta));
+        };
+
+        uint32_t count = static_cast<uint32_t>(side * side * 2);
+        std::string stl(80 + 4 + static_cast<size_t>(count) * 50, '\0');
+        std::memcpy(&stl[80], &count, 4);
+
+        char* out = &stl[84];
+        auto triangle = [&](size_t a0, size_t a1, size_t b0, size_t b1, size_t c0, size_t c1) {
+            float data[12] = {};
+            point(a0, a1, data + 3);
+            point(b0, b1, data + 6);
+            point(c0, c1, data + 9);
+            std::memcpy(out, data, sizeof(data));
+            out += 50;
+        };
+        for (size_t i = 0; i < side; ++i) {
+            for (size_t j = 0; j < side; ++j) {
+                triangle(i, j, i + 1, j, i + 1, j + 1);
+                triangle(i, j, i + 1, j + 1, i, j + 1);
+            }
+        }
+        return stl;
+    }
+
+    double percentile(std::vector<double>& values, double p) {
+        if (values.empty()) return 0.0;
+        size_t index = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    bool optionSize(const std::string& arg, const char* name, size_t& value) {
+        std::string prefix = std::string("--") + name + "=";
+        if (arg.rfind(prefix, 0) != 0) return false;
+        value = std::strtoull(arg.c_str() + prefix.size(), nullptr, 10);
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t requests = 200, concurrency = 8, objects = 8, triangles = 200000, port = 18080;
+    stl2glb::FakeS3Config config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (!optionSize(arg, "requests", requests) && !optionSize(arg, "concurrency", concurrency) &&
+            !optionSize(arg, "objects", objects) && !optionSize(arg, "triangles", triangles) &&
+            !optionSize(arg, "port", port) && !config.parseOption(arg)) {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return 2;
+        }
+    }
+    concurrency = std::max<size_t>(concurrency, 1);
+    objects = std::max<size_t>(objects, 1);
+
+    // Server S3 finto con gli STL già caricati
+    stl2glb::FakeS3Server s3(config);
+    int s3Port = s3.start("127.0.0.1", 0);
+    size_t stlBytes = 0;
+    for (size_t i = 0; i < objects; ++i) {
+        std::string stl = makeSphereStl(triangles, 50.0 + static_cast<double>(i));
+        stlBytes = stl.size();
+        s3.putObject("stl", "bench-" + std::to_string(i), std::move(stl));
+    }
+
+    // Servizio configurato verso il server finto
+    std::string endpoint = "127.0.0.1:" + std::to_string(s3Port);
+    setenv("STL2GLB_STORAGE", "s3", 1);
+    setenv("STL2GLB_MINIO_ENDPOINT", endpoint.c_str(), 1);
+    setenv("STL2GLB_MINIO_ACCESS_KEY", "bench", 1);
+    setenv("STL2GLB_MINIO_SECRET_KEY", "bench-secret", 1);
+    setenv("STL2GLB_STL_BUCKET_NAME", "stl", 1);
+    setenv("STL2GLB_GLB_BUCKET_NAME", "glb", 1);
+    setenv("STL2GLB_RESULT_CACHE_SIZE", "0", 0);
+    setenv("STL2GLB_RESULT_CACHE_INDEX", "", 0);
+    stl2glb::EnvironmentHandler::instance().init();
+
+    // Server::start non ritorna: il thread resta attivo fino all'uscita del processo
+    int servicePort = static_cast<int>(port);
+    std::thread([servicePort] { stl2glb::Server().start(servicePort); }).detach();
+
+    httplib::Client probe("127.0.0.1", servicePort);
+    bool ready = false;
+    for (int attempt = 0; attempt < 100 && !ready; ++attempt) {
+        auto res = probe.Get("/health");
+        ready = res && res->status == 200;
+        if (!ready) std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    if (!ready) {
+        std::fprintf(stderr, "Service did not start on port %d\n", servicePort);
+        std::_Exit(1);
+    }
+
+    std::printf("%zu requests, %zu connections, %zu objects of %.1f MB, fake S3 on %s\n",
+                requests, concurrency, objects, stlBytes / 1e6, endpoint.c_str());
+
+    // Generatore di carico: una connessione keep-alive per worker
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> failures{0};
+    std::mutex latencyMutex;
+    std::vector<double> latencies;
+    latencies.reserve(requests);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < concurrency; ++w) {
+        workers.emplace_back([&] {
+            httplib::Client client("127.0.0.1", servicePort);
+            client.set_keep_alive(true);
+            client.set_read_timeout(300);
+
+            std::vector<double> local;
+            for (size_t i = next++; i < requests; i = next++) {
+                std::string body = "{\"stl_hash\":\"bench-" + std::to_string(i % objects) + "\"}";
+                auto begin = std::chrono::steady_clock::now();
+                auto res = client.Post("/convert", body, "application/json");
+                local.push_back(std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - begin).count());
+                if (!res || res->status != 200) ++failures;
+            }
+
+            std::lock_guard<std::mutex> lock(latencyMutex);
+            latencies.insert(latencies.end(), local.begin(), local.end());
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("throughput %.2f req/s, %.1f MB/s STL, %zu failed\n", requests / seconds,
+                requests * (stlBytes / 1e6) / seconds, failures.load());
+    std::printf("latency p50 %.1f ms, p95 %.1f ms, p99 %.1f ms, max %.1f ms\n", percentile(latencies, 50),
+                percentile(latencies, 95), percentile(latencies, 99), percentile(latencies, 100));
+
+    auto s = s3.stats();
+    std::printf("fake S3: %llu requests on %llu connections, %llu GET, %llu HEAD, %llu PUT, %llu POST, "
+                "%.1f MB sent, %.1f MB received, %llu errors and %llu resets injected\n",
+                (unsigned long long) s.requests, (unsigned long long) s.connections, (unsigned long long) s.gets,
+                (unsigned long long) s.heads, (unsigned long long) s.puts, (unsigned long long) s.posts,
+                s.bytesSent / 1e6, s.bytesReceived / 1e6, (unsigned long long) s.injectedErrors,
+                (unsigned long long) s.injectedResets);
+
+    if (auto res = probe.Get("/stats")) {
+        std::printf("service /stats: %s\n", res->body.c_str());
+    }
+
+    // Il thread del servizio non si può fermare: uscita senza distruttori statici
+    std::fflush(stdout);
+    std::_Exit(failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,103 @@
+// Benchmark del kernel di validazione: costo per triangolo per ogni ISA
+// supportato e verifica di uguaglianza bit a bit con il percorso scalare.
+//
+// Uso: bench_triangle_kernel [numero_triangoli] [ripetizioni]
+#include "stl2glb/TriangleKernel.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using stl2glb::Mesh;
+using stl2glb::TriangleKernel;
+
+namespace {
+
+    // Mesh sintetica con una piccola percentuale di record da scartare o correggere
+    std::vector<uint8_t> makeRecords(size_t count) {
+        std::vector<uint8_t> records(count * sizeof(stl2glb::STLTriangleRaw));
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+        std::uniform_int_distribution<int> kind(0, 99);
+
+        for (size_t i = 0; i < count; ++i) {
+            float f[12];
+            for (auto& v : f) v = coord(rng);
+
+            switch (kind(rng)) {
+                case 0: f[4] = std::numeric_limits<float>::quiet_NaN(); break;  // vertice non valido
+                case 1: std::memcpy(f + 6, f + 3, 3 * sizeof(float)); break;     // degenere
+                case 2: f[0] = f[1] = f[2] = 0.0f; break;                         // normale mancante
+                default: break;
+            }
+
+            std::memcpy(records.data() + i * sizeof(stl2glb::STLTriangleRaw), f, sizeof(f));
+        }
+        return records;
+    }
+
+    bool sameOutput(const Mesh& a, const Mesh& b, size_t count) {
+        return std::memcmp(a.positions(), b.positions(), count * Mesh::FLOATS_PER_TRIANGLE * sizeof(float)) == 0 &&
+               std::memcmp(a.normals(), b.normals(), count * Mesh::FLOATS_PER_NORMAL * sizeof(float)) == 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    auto records = makeRecords(count);
+    Mesh reference;
+    reference.resize(count);
+    std::vector<uint32_t> referenceRejected;
+    size_t referenceCount = TriangleKernel::process(TriangleKernel::Isa::Scalar, records.data(), count,
+                                                    reference.positions(), reference.normals(),
+                                                    referenceRejected);
+
+    std::printf("triangles: %zu, valid: %zu, best ISA: %s\n", count, referenceCount,
+                TriangleKernel::isaName(TriangleKernel::detectIsa()));
+
+    const TriangleKernel::Isa isas[] = {
+            TriangleKernel::Isa::Scalar,
+            TriangleKernel::Isa::SSE42,
+            TriangleKernel::Isa::AVX2,
+            TriangleKernel::Isa::AVX512
+    };
+
+    int failures = 0;
+    Mesh out;
+    out.resize(count);
+    std::vector<uint32_t> rejected;
+    rejected.reserve(referenceRejected.size());
+
+    for (auto isa : isas) {
+        if (static_cast<int>(isa) > static_cast<int>(TriangleKernel::detectIsa())) {
+            continue;
+        }
+
+        double best = std::numeric_limits<double>::max();
+        size_t written = 0;
+        for (int r = 0; r < repeats; ++r) {
+            rejected.clear();
+            auto start = std::chrono::steady_clock::now();
+            written = TriangleKernel::process(isa, records.data(), count, out.positions(), out.normals(), rejected);
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+        }
+
+        bool identical = written == referenceCount && rejected == referenceRejected &&
+                         sameOutput(out, reference, written);
+        if (!identical) ++failures;
+
+        std::printf("%-8s %8.3f ns/triangle %10.1f Mtri/s  %s\n",
+                    TriangleKernel::isaName(isa), best / count, count / best * 1e3,
+                    identical ? "bit-identical" : "MISMATCH");
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+// Benchmark della saldatura esatta dei vertici: std::map (implementazione
+// precedente di GLBWriter) contro VertexWeldTable, e VertexWelder sequenziale
+// contro quello parallelo con radix sort, su mesh tipiche da CAD.
+//
+// Uso: bench_weld [numero_triangoli]
+#include "stl2glb/VertexWeldTable.hpp"
+#include "stl2glb/VertexWelder.hpp"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace {
+
+    struct WeldResult {
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    // Griglia deformata su una sfera: ogni vertice interno è condiviso da 6 triangoli,
+    // come in una superficie tassellata da un esportatore CAD
+    std::vector<float> makeSphereSoup(size_t targetTriangles) {
+        size_t side = static_cast<size_t>(std::sqrt(targetTriangles / 2.0)) + 1;
+        std::vector<float> grid((side + 1) * (side + 1) * 3);
+        for (size_t i = 0; i <= side; ++i) {
+            for (size_t j = 0; j <= side; ++j) {
+                double theta = M_PI * i / side;
+                double phi = 2.0 * M_PI * j / side;
+                float* p = &grid[(i * (side + 1) + j) * 3];
+                p[0] = static_cast<float>(50.0 * std::sin(theta) * std::cos(phi));
+                p[1] = static_cast<float>(50.0 * std::sin(theta) * std::sin(phi));
+                p[2] = static_cast<float>(50.0 * std::cos(theta));
+            }
+        }
+
+        std::vector<float> soup;
+        soup.reserve(side * side * 18);
+        auto corner = [&](size_t i, size_t j) {
+            const float* p = &grid[(i * (side + 1) + j) * 3];
+            soup.insert(soup.end(), p, p + 3);
+        };
+        for (size_t i = 0; i < side; ++i) {
+            for (size_t j = 0; j < side; ++j) {
+                corner(i, j); corner(i + 1, j); corner(i + 1, j + 1);
+                corner(i, j); corner(i + 1, j + 1); corner(i, j + 1);
+            }
+        }
+        return soup;
+    }
+
+    WeldResult weldWithMap(const std::vector<float>& soup) {
+        WeldResult result;
+        std::map<std::array<float, 3>, uint32_t> unique;
+        for (size_t c = 0; c < soup.size() / 3; ++c) {
+            std::array<float, 3> v = {soup[c * 3], soup[c * 3 + 1], soup[c * 3 + 2]};
+            auto it = unique.find(v);
+            uint32_t index;
+            if (it != unique.end()) {
+                index = it->second;
+            } else {
+                index = static_cast<uint32_t>(result.vertices.size() / 3);
+                unique[v] = index;
+                result.vertices.insert(result.vertices.end(), v.begin(), v.end());
+            }
+            result.indices.push_back(index);
+        }
+        return result;
+    }
+
+    WeldResult weldWithTable(const std::vector<float>& soup) {
+        WeldResult result;
+        stl2glb::VertexWeldTable unique(soup.size() / 9);
+        for (size_t c = 0; c < soup.size() / 3; ++c) {
+            const float* v = &soup[c * 3];
+            uint32_t next = static_cast<uint32_t>(result.vertices.size() / 3);
+            uint32_t index = unique.findOrInsert(v, next);
+            if (index == next) {
+                result.vertices.insert(result.vertices.end(), v, v + 3);
+            }
+            result.indices.push_back(index);
+        }
+        return result;
+    }
+
+    template <typename Fn, typename Result>
+    double timeMs(Fn&& fn, Result& out) {
+        auto start = std::chrono::steady_clock::now();
+        out = fn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    bool sameIndexedMesh(const stl2glb::IndexedMesh& a, const stl2glb::IndexedMesh& b) {
+        return a.vertices.size() == b.vertices.size() && a.indices.size() == b.indices.size() &&
+               a.normals.size() == b.normals.size() &&
+               std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.byteSize()) == 0 &&
+               std::memcmp(a.normals.data(), b.normals.data(), a.normals.byteSize()) == 0 &&
+               std::memcmp(a.indices.data(), b.indices.data(), a.indices.byteSize()) == 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t triangles = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    auto soup = makeSphereSoup(triangles);
+
+    WeldResult fromMap, fromTable;
+    double mapMs = timeMs([&] { return weldWithMap(soup); }, fromMap);
+    double tableMs = timeMs([&] { return weldWithTable(soup); }, fromTable);
+
+    bool identical = fromMap.vertices == fromTable.vertices && fromMap.indices == fromTable.indices;
+
+    std::printf("triangles: %zu, unique vertices: %zu\n", soup.size() / 9, fromTable.vertices.size() / 3);
+    std::printf("std::map         %10.1f ms\n", mapMs);
+    std::printf("VertexWeldTable  %10.1f ms  (%.1fx)  %s\n", tableMs, mapMs / tableMs,
+                identical ? "identical output" : "MISMATCH");
+
+    // Stessa geometria come Mesh, con una normale per faccia
+    stl2glb::Mesh mesh;
+    mesh.resize(soup.size() / 9);
+    std::memcpy(mesh.positions(), soup.data(), soup.size() * sizeof(float));
+    for (size_t t = 0; t < mesh.triangleCount(); ++t) {
+        float* n = mesh.normals() + t * 3;
+        n[0] = 0.0f;
+        n[1] = 0.0f;
+        n[2] = static_cast<float>(t);
+    }
+
+    stl2glb::IndexedMesh sequential, parallel;
+    double seqMs = timeMs([&] { return stl2glb::VertexWelder::weldSequential(mesh); }, sequential);
+    double parMs = timeMs([&] { return stl2glb::VertexWelder::weldParallel(mesh); }, parallel);
+    bool deterministic = sameIndexedMesh(sequential, parallel);
+
+    std::printf("weldSequential   %10.1f ms\n", seqMs);
+    std::printf("weldParallel     %10.1f ms  (%.1fx)  %s\n", parMs, seqMs / parMs,
+                deterministic ? "identical output" : "MISMATCH");
+
+    return identical && deterministic ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+// Server S3 finto (FakeS3Server) come processo a sé, da usare come endpoint
+// MinIO del servizio: STL2GLB_MINIO_ENDPOINT=127.0.0.1:<porta>, credenziali
+// qualsiasi. Gli oggetti vivono in memoria; i contatori sono su GET /-/stats.
+//
+// Uso: fake_s3_server [--port=9000] [--host=127.0.0.1] [--latency-ms=N]
+//      [--bandwidth-mb-per-s=N] [--error-rate=0..1] [--reset-rate=0..1]
+//      [--slow-start-kb=N] [--slow-start-rtt-ms=N] [--threads=N] [--seed=N]
+#include "FakeS3Server.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+int main(int argc, char** argv) {
+    try {
+        stl2glb::FakeS3Config config;
+        std::string host = "127.0.0.1";
+        int port = 9000;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--port=", 0) == 0) {
+                port = std::atoi(arg.c_str() + 7);
+            } else if (arg.rfind("--host=", 0) == 0) {
+                host = arg.substr(7);
+            } else if (!config.parseOption(arg)) {
+                std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+                return 2;
+            }
+        }
+
+        stl2glb::FakeS3Server server(config);
+        server.listen(host, port);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
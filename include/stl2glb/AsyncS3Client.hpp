@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "stl2glb/AwsV4Signer.hpp"
+#include "stl2glb/MinioClientConfig.hpp"
+
+namespace stl2glb {
+
+/**
+ * @struct AsyncS3Request
+ * @brief Richiesta S3 da eseguire su AsyncS3Client
+ *
+ * Il corpo è in memoria (body) oppure un intervallo di un file (bodyFile,
+ * bodyOffset, bodyLength), letto a blocchi durante l'invio. Con responseFile
+ * il corpo di una risposta 2xx viene scritto direttamente nel file.
+ */
+    struct AsyncS3Request {
+        std::string method = "GET";
+        std::string path;            // "/bucket/oggetto", già codificato
+        std::string query;           // Query canonica senza '?', es. "partNumber=1&uploadId=abc"
+        std::vector<std::pair<std::string, std::string>> headers;  // Header aggiuntivi non firmati (Range, Content-Type)
+
+        std::string body;
+        std::string bodyFile;
+        uint64_t bodyOffset = 0;
+        uint64_t bodyLength = 0;
+        // SHA-256 del corpo se noto; vuoto: calcolato per body, UNSIGNED-PAYLOAD per bodyFile
+        std::string payloadHash;
+
+        std::string responseFile;
+    };
+
+/**
+ * @struct AsyncS3Response
+ * @brief Esito di una richiesta: stato HTTP, header (nomi in minuscolo) e corpo
+ */
+    struct AsyncS3Response {
+        int status = 0;
+        std::map<std::string, std::string> headers;
+        std::string body;            // Vuoto se il corpo è andato in responseFile
+        uint64_t bodyBytes = 0;
+    };
+
+/**
+ * @class AsyncS3Client
+ * @brief Trasporto S3 asincrono: molte richieste su pochi thread di I/O (epoll)
+ *
+ * Ognuno degli io_threads thread di I/O ha il proprio event loop epoll con
+ * socket non bloccanti e connessioni keep-alive verso l'endpoint (al massimo
+ * pool_size per loop). submit() firma la richiesta (AwsV4Signer) sul thread chiamante e la affida
+ * a un loop; il completamento arriva come callback, eseguita sul thread di
+ * I/O e quindi da tenere breve, oppure come std::future. Le richieste oltre
+ * il limite di connessioni restano in coda nel loop.
+ *
+ * Il client non ripete le richieste: stati di errore arrivano nella risposta
+ * (o come eccezione per get/put/head), errori di rete e timeout
+ * (timeout_seconds di inattività) come eccezione. Una connessione keep-alive
+ * chiusa dal server mentre era inattiva viene sostituita in modo trasparente.
+ * Solo endpoint http:// e solo Linux.
+ */
+    class AsyncS3Client {
+    public:
+        using Callback = std::function<void(std::exception_ptr error, AsyncS3Response&& response)>;
+
+        AsyncS3Client(const std::string& endpoint,
+                      const std::string& accessKey,
+                      const std::string& secretKey,
+                      const MinioClientSettings& settings = {});
+        ~AsyncS3Client();
+
+        AsyncS3Client(const AsyncS3Client&) = delete;
+        AsyncS3Client& operator=(const AsyncS3Client&) = delete;
+
+        // Client condiviso del processo, configurato da EnvironmentHandler alla prima chiamata
+        static AsyncS3Client& instance();
+
+        void submit(AsyncS3Request request, Callback done);
+        std::future<AsyncS3Response> submit(AsyncS3Request request);
+
+        // Operazioni comuni; la future contiene un'eccezione anche per stati non 2xx.
+        // get: corpo in memoria se localPath è vuoto, altrimenti scritto nel file
+        std::future<AsyncS3Response> get(const std::string& bucket,
+                                         const std::string& objectName,
+                                         const std::string& localPath = "");
+        std::future<AsyncS3Response> put(const std::string& bucket,
+                                         const std::string& objectName,
+                                         const std::string& localPath,
+                                         const std::string& payloadSha256 = "");
+        // HEAD: status 404 non è un errore
+        std::future<AsyncS3Response> head(const std::string& bucket, const std::string& objectName);
+
+        // Richieste in coda o in corso
+        size_t pending() const { return inFlight.load(); }
+
+    private:
+        class Loop;
+        struct Transfer;
+
+        std::future<AsyncS3Response> submitChecked(AsyncS3Request request, bool allowNotFound);
+
+        std::string hostHeader;
+        MinioClientSettings settings;
+        AwsV4Signer signer;
+        std::vector<std::unique_ptr<Loop>> loops;
+        std::atomic<size_t> nextLoop{0};
+        std::atomic<size_t> inFlight{0};
+    };
+
+} // namespace stl2glb
@@ -0,0 +1,72 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <httplib.h>
+
+namespace stl2glb {
+
+/**
+ * @class AwsV4Signer
+ * @brief Firma AWS Signature V4 delle richieste S3
+ *
+ * La signing key (kDate -> kRegion -> kService -> kSigning) dipende solo dalla
+ * data e viene derivata una volta al giorno. Algoritmi OpenSSL già risolti
+ * (EVP_MAC_fetch / EVP_MD_fetch), contesti HMAC e SHA-256 e buffer delle
+ * stringhe canoniche sono riutilizzati per thread, quindi una firma costa
+ * essenzialmente due SHA-256 e un HMAC su poche centinaia di byte.
+ */
+    class AwsV4Signer {
+    public:
+        using Key = std::array<unsigned char, 32>;
+
+        AwsV4Signer(std::string accessKey, std::string secretKey,
+                    std::string region = "us-east-1", std::string service = "s3");
+
+        /**
+         * @brief Aggiunge a headers Host, x-amz-date, x-amz-content-sha256 e Authorization
+         *
+         * @param host Host (con porta) come inviato nell'header Host
+         * @param canonicalUri Path della richiesta, già codificato
+         * @param payloadHash SHA-256 esadecimale del corpo (o "UNSIGNED-PAYLOAD")
+         */
+        void sign(httplib::Headers& headers,
+                  const std::string& method,
+                  const std::string& host,
+                  const std::string& canonicalUri,
+                  const std::string& payloadHash,
+                  std::chrono::system_clock::time_point now = std::chrono::system_clock::now()) const;
+
+        /**
+         * @brief Come sign, per richieste con query string (es. upload multipart)
+         *
+         * @param canonicalQuery Parametri già codificati e ordinati per nome,
+         *        "nome=valore" separati da '&' (es. "partNumber=1&uploadId=abc")
+         */
+        void sign(httplib::Headers& headers,
+                  const std::string& method,
+                  const std::string& host,
+                  const std::string& canonicalUri,
+                  const std::string& canonicalQuery,
+                  const std::string& payloadHash,
+                  std::chrono::system_clock::time_point now = std::chrono::system_clock::now()) const;
+
+        // Signing key per una data "YYYYMMDD", dalla cache se la data è quella corrente
+        Key signingKey(const std::string& dateStamp) const;
+
+    private:
+        Key deriveSigningKey(const std::string& dateStamp) const;
+
+        std::string accessKey;
+        std::string secretKey;
+        std::string region;
+        std::string service;
+
+        mutable std::mutex keyMutex;
+        mutable std::string cachedDate;
+        mutable Key cachedKey{};
+    };
+
+} // namespace stl2glb
@@ -0,0 +1,29 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace stl2glb {
+
+/**
+ * @class Blake3
+ * @brief Hash BLAKE3 (32 byte, modalità non keyed) con calcolo parallelo dell'albero
+ *
+ * BLAKE3 divide l'input in chunk da 1 KB che formano le foglie di un albero
+ * binario: i sottoalberi sinistro e destro di ogni nodo sono indipendenti e
+ * vengono calcolati su thread diversi fino a esaurire i core. Il risultato è
+ * identico a quello dell'implementazione di riferimento (b3sum), indipendentemente
+ * dal numero di thread.
+ */
+    class Blake3 {
+    public:
+        static constexpr size_t OUT_LEN = 32;
+        using Digest = std::array<uint8_t, OUT_LEN>;
+
+        /**
+         * @param numThreads Numero massimo di thread, 0 per usare tutti i core
+         */
+        static Digest hash(const void* data, size_t size, unsigned numThreads = 0);
+    };
+
+} // namespace stl2glb
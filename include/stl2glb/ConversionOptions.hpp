@@ -0,0 +1,46 @@
+#pragma once
+#include <stdexcept>
+#include <string>
+
+namespace stl2glb {
+
+/**
+ * @enum WeldMode
+ * @brief Criterio con cui due vertici vengono considerati lo stesso vertice
+ */
+    enum class WeldMode {
+        Exact,     // Coordinate float identiche
+        Tolerance  // Distanza entro weldTolerance, tramite griglia spaziale
+    };
+
+/**
+ * @struct ConversionOptions
+ * @brief Opzioni di conversione scelte per singola richiesta
+ */
+    struct ConversionOptions {
+        WeldMode weldMode = WeldMode::Exact;
+
+        // Tolleranza assoluta nelle unità del file STL; se <= 0 viene
+        // ricavata dalla diagonale del bounding box (DEFAULT_RELATIVE_TOLERANCE)
+        float weldTolerance = 0.0f;
+
+        static constexpr float DEFAULT_RELATIVE_TOLERANCE = 1e-6f;
+
+        // Parse e saldatura in un'unica passata sul file binario (saldatura esatta):
+        // nessuna Mesh intermedia, ma saldatura su un solo thread. Con false la
+        // Mesh viene materializzata e le mesh molto grandi usano la saldatura parallela.
+        // L'output è identico nei due casi.
+        bool fusedParse = true;
+
+        static WeldMode weldModeFromString(const std::string& name) {
+            if (name == "exact") return WeldMode::Exact;
+            if (name == "tolerance") return WeldMode::Tolerance;
+            throw std::runtime_error("Unknown weld mode: " + name);
+        }
+
+        static const char* weldModeName(WeldMode mode) {
+            return mode == WeldMode::Tolerance ? "tolerance" : "exact";
+        }
+    };
+
+} // namespace stl2glb
@@ -1,11 +1,19 @@
 #pragma once
 #include <string>
+#include "stl2glb/ConversionOptions.hpp"
 
 namespace stl2glb {
 
     class Converter {
     public:
-        static std::string run(const std::string& stl_hash);
+        // Versione dell'output: va incrementata a ogni modifica che cambia i byte del GLB
+        static constexpr const char* VERSION = "2.0.0+glb.1";
+
+        static std::string run(const std::string& stl_hash, const ConversionOptions& options = {});
+
+        // Chiave (esadecimale) della cache dei risultati: STL, opzioni che influiscono
+        // sull'output, writer e algoritmo di hash configurati, VERSION
+        static std::string cacheKey(const std::string& stl_hash, const ConversionOptions& options = {});
     };
 
 } // namespace stl2glb
@@ -1,5 +1,8 @@
 #pragma once
+#include <cstddef>
 #include <string>
+#include "stl2glb/MinioClientConfig.hpp"
+#include "stl2glb/StorageBackend.hpp"
 
 namespace stl2glb {
 
@@ -12,19 +15,56 @@ namespace stl2glb {
         const std::string& getStlBucketName() const;
         const std::string& getGlbBucketName() const;
 
+        // Opzionali STL2GLB_STORAGE: "s3" (default), "filesystem" o "memory", e
+        // STL2GLB_STORAGE_ROOT (directory del backend filesystem)
+        StorageType getStorageType() const;
+        const std::string& getStorageRoot() const;
+
+        // Richiesti solo con STL2GLB_STORAGE=s3
         const std::string& getMinioEndpoint() const;
         const std::string& getMinioAccessKey() const;
         const std::string& getMinioSecretKey() const;
 
+        // Opzionale STL2GLB_GLB_WRITER: "direct" (default) o "tinygltf"
+        bool useTinyGltfWriter() const;
+
+        // Opzionale STL2GLB_CONTENT_HASH: "sha256" (default) o "blake3"
+        bool useBlake3ContentHash() const;
+
+        // Opzionali STL2GLB_RESULT_CACHE_SIZE (voci, 0 disabilita; default 10000),
+        // STL2GLB_RESULT_CACHE_INDEX (file indice, vuoto = solo memoria)
+        // e STL2GLB_RESULT_CACHE_MIRROR ("true" per replicare l'indice nel bucket GLB)
+        size_t getResultCacheSize() const;
+        const std::string& getResultCacheIndexPath() const;
+        bool mirrorResultCache() const;
+
+        // Opzionali STL2GLB_MINIO_POOL_SIZE, STL2GLB_MINIO_POOL_IDLE_SECONDS, STL2GLB_MINIO_RETRY_COUNT,
+        // STL2GLB_MINIO_TIMEOUT_SECONDS, STL2GLB_MINIO_HEDGE_PERCENTILE, STL2GLB_MINIO_IO, STL2GLB_MINIO_IO_THREADS,
+        // STL2GLB_DOWNLOAD_PART_MB, STL2GLB_DOWNLOAD_CONCURRENCY, STL2GLB_PARALLEL_DOWNLOAD_MIN_MB,
+        // STL2GLB_MULTIPART_PART_MB, STL2GLB_UPLOAD_CONCURRENCY e STL2GLB_MULTIPART_MIN_MB
+        const MinioClientSettings& getMinioClientSettings() const;
+
     private:
         EnvironmentHandler() = default;
 
         std::string stlBucketName;
         std::string glbBucketName;
 
+        StorageType storageType = StorageType::S3;
+        std::string storageRoot = "/var/lib/stl2glb";
+
         std::string minioEndpoint;
         std::string minioAccessKey;
         std::string minioSecretKey;
+
+        bool tinyGltfWriter = false;
+        bool blake3ContentHash = false;
+
+        size_t resultCacheSize = 10000;
+        std::string resultCacheIndexPath = "/tmp/stl2glb-result-cache.idx";
+        bool resultCacheMirror = false;
+
+        MinioClientSettings minioClientSettings;
     };
 
 } // namespace stl2glb
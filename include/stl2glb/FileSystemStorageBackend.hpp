@@ -0,0 +1,59 @@
+#pragma once
+#include <filesystem>
+#include "stl2glb/StorageBackend.hpp"
+
+namespace stl2glb {
+
+/**
+ * @class FileSystemStorageBackend
+ * @brief StorageBackend su una directory locale
+ *
+ * L'oggetto <bucket>/<nome> è il file <radice>/<bucket>/<nome>; i nomi con
+ * "/" creano sottodirectory. Le scritture passano da un file temporaneo nella
+ * stessa directory rinominato al termine, quindi un lettore concorrente vede
+ * l'oggetto precedente o quello nuovo, mai uno parziale. Nomi assoluti o con
+ * componenti "." e ".." vengono rifiutati.
+ */
+    class FileSystemStorageBackend : public StorageBackend {
+    public:
+        explicit FileSystemStorageBackend(const std::string& root);
+
+        const char* name() const override { return "filesystem"; }
+
+        void get(const std::string& bucket,
+                 const std::string& objectName,
+                 const std::string& localPath) override;
+
+        void getRange(const std::string& bucket,
+                      const std::string& objectName,
+                      uint64_t offset,
+                      uint64_t length,
+                      std::string& content) override;
+
+        void put(const std::string& bucket,
+                 const std::string& objectName,
+                 const std::string& localPath,
+                 const std::string& payloadSha256 = "") override;
+
+        bool head(const std::string& bucket,
+                  const std::string& objectName,
+                  uint64_t* size = nullptr) override;
+
+        bool getText(const std::string& bucket,
+                     const std::string& objectName,
+                     std::string& content) override;
+        void putText(const std::string& bucket,
+                     const std::string& objectName,
+                     const std::string& content) override;
+
+    private:
+        // Percorso dell'oggetto sotto la radice; lancia se bucket o nome non sono validi
+        std::filesystem::path objectPath(const std::string& bucket, const std::string& objectName) const;
+
+        // File temporaneo accanto a target, con le directory intermedie create
+        static std::filesystem::path stagingPath(const std::filesystem::path& target);
+
+        std::filesystem::path root;
+    };
+
+} // namespace stl2glb
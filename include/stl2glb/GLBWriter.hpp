@@ -1,14 +1,33 @@
 #pragma once
 #include <string>
-#include <vector>
-#include "STLParser.hpp"
+#include "stl2glb/Mesh.hpp"
+#include "stl2glb/ConversionOptions.hpp"
+#include "stl2glb/VertexWelder.hpp"
 
 namespace stl2glb {
 
     class GLBWriter {
     public:
-        static void write(const std::vector<Triangle>& triangles,
-                          const std::string& outputPath);
+        // Salda e scrive; restituisce lo SHA-256 esadecimale del file scritto
+        static std::string write(const Mesh& input,
+                                 const std::string& outputPath,
+                                 const ConversionOptions& options = {});
+
+        /**
+         * @brief Scrive una mesh già saldata (ad esempio da STLParser::parseWelded)
+         *
+         * Serializzatore diretto: JSON compatto e chunk BIN scritto con writev
+         * dai buffer della IndexedMesh, senza copie intermedie della geometria.
+         * L'hash viene calcolato durante la scrittura tramite HashingFileWriter.
+         *
+         * @return std::string SHA-256 esadecimale del file scritto
+         */
+        static std::string write(const IndexedMesh& welded,
+                                 const std::string& outputPath);
+
+        // Percorso di riserva tramite tinygltf::Model (copia la geometria nel modello)
+        static void writeWithTinyGltf(const IndexedMesh& welded,
+                                      const std::string& outputPath);
     };
 
 } // namespace stl2glb
@@ -1,11 +1,65 @@
 #pragma once
+#include <cstddef>
 #include <string>
 
+struct evp_md_ctx_st;
+
 namespace stl2glb {
 
+/**
+ * @class Hasher
+ * @brief SHA-256 di file e buffer in memoria
+ *
+ * I file regolari sono mappati in memoria con hint di lettura sequenziale e
+ * passati al digest a blocchi da 4 MB, rilasciando le pagine già elaborate;
+ * gli altri sono letti a blocchi interi da 4 MB. Ogni EVP_DigestUpdate copre
+ * un blocco intero, quindi OpenSSL usa i percorsi SHA-NI/AVX2 senza overhead per chiamata.
+ *
+ * In alternativa fornisce BLAKE3 (vedi Blake3), il cui albero di hash viene
+ * calcolato in parallelo su tutti i core.
+ */
     class Hasher {
     public:
+        // Dimensione dei blocchi di lettura e di aggiornamento del digest
+        static constexpr size_t BLOCK_SIZE = 4 * 1024 * 1024;
+
         static std::string sha256_file(const std::string& path);
+
+        // SHA-256 esadecimale di un buffer in memoria
+        static std::string sha256(const void* data, size_t size);
+
+        // BLAKE3 esadecimale di un file, mappato interamente e calcolato su tutti i core
+        static std::string blake3_file(const std::string& path);
+
+        // BLAKE3 esadecimale di un buffer in memoria
+        static std::string blake3(const void* data, size_t size);
+
+        // Rappresentazione esadecimale minuscola di un digest
+        static std::string toHex(const unsigned char* digest, size_t length);
+    };
+
+/**
+ * @class Sha256
+ * @brief Contesto SHA-256 incrementale (EVP di OpenSSL)
+ *
+ * Permette di calcolare l'hash dei dati mentre vengono prodotti o scritti,
+ * senza rileggerli in seguito.
+ */
+    class Sha256 {
+    public:
+        Sha256();
+        ~Sha256();
+
+        Sha256(const Sha256&) = delete;
+        Sha256& operator=(const Sha256&) = delete;
+
+        void update(const void* data, size_t size);
+
+        // Finalizza e restituisce il digest in esadecimale; il contesto non va più aggiornato
+        std::string hexDigest();
+
+    private:
+        evp_md_ctx_st* ctx;
     };
 
 } // namespace stl2glb
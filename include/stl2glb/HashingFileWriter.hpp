@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include "stl2glb/Hasher.hpp"
+
+#ifdef _WIN32
+#include <fstream>
+#endif
+
+namespace stl2glb {
+
+/**
+ * @class HashingFileWriter
+ * @brief Scrittura su file che calcola lo SHA-256 di ogni byte emesso
+ *
+ * I segmenti sono scritti con writev direttamente dai buffer del chiamante
+ * e passati al contesto SHA-256 mentre sono ancora in cache: l'hash del file
+ * è disponibile alla chiusura senza rileggerlo.
+ */
+    class HashingFileWriter {
+    public:
+        // Porzione contigua da scrivere
+        struct Segment {
+            const void* data;
+            size_t size;
+        };
+
+        /**
+         * @brief Crea (o tronca) il file di output
+         * @throws std::runtime_error se il file non può essere aperto
+         */
+        explicit HashingFileWriter(const std::string& path);
+
+        // Chiude il file se finish() non è stato chiamato (ad esempio dopo un'eccezione)
+        ~HashingFileWriter();
+
+        HashingFileWriter(const HashingFileWriter&) = delete;
+        HashingFileWriter& operator=(const HashingFileWriter&) = delete;
+
+        // Scrive i segmenti in ordine e ne aggiorna l'hash
+        void write(std::initializer_list<Segment> segments);
+
+        /**
+         * @brief Chiude il file e restituisce lo SHA-256 esadecimale del contenuto
+         * @throws std::runtime_error se la chiusura fallisce
+         */
+        std::string finish();
+
+        uint64_t bytesWritten() const { return written; }
+
+    private:
+        std::string path;
+        Sha256 hash;
+        uint64_t written = 0;
+
+#ifdef _WIN32
+        std::ofstream file;
+#else
+        int fd = -1;
+#endif
+    };
+
+} // namespace stl2glb
@@ -0,0 +1,108 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace httplib {
+    class Client;
+}
+
+namespace stl2glb {
+
+/**
+ * @struct HttpPoolStats
+ * @brief Contatori di utilizzo di un HttpConnectionPool
+ */
+    struct HttpPoolStats {
+        uint64_t created = 0;    // Connessioni aperte
+        uint64_t reused = 0;     // Acquire serviti da una connessione inattiva
+        uint64_t evicted = 0;    // Connessioni chiuse perché inattive troppo a lungo
+        uint64_t discarded = 0;  // Connessioni scartate dopo un errore
+        uint64_t waits = 0;      // Acquire che hanno atteso una connessione libera
+        size_t idle = 0;
+        size_t leased = 0;
+    };
+
+/**
+ * @class HttpConnectionPool
+ * @brief Pool di client HTTP keep-alive verso un singolo host
+ *
+ * Ogni httplib::Client mantiene aperta la propria connessione tra una richiesta
+ * e l'altra; il pool li presta in uso esclusivo (httplib::Client non è
+ * thread-safe) e li riprende al termine. Le connessioni inattive da più di
+ * idleTimeout vengono chiuse alla prima acquire o release successiva. Se tutte
+ * le maxSize connessioni sono in uso, acquire attende che una venga restituita.
+ */
+    class HttpConnectionPool {
+    public:
+        /**
+         * @class Lease
+         * @brief Connessione in prestito, restituita al pool alla distruzione
+         */
+        class Lease {
+        public:
+            Lease(Lease&& other) noexcept;
+            Lease& operator=(Lease&&) = delete;
+            ~Lease();
+
+            httplib::Client& operator*() const { return *client; }
+            httplib::Client* operator->() const { return client.get(); }
+
+            // La connessione non torna nel pool (es. dopo un errore di rete)
+            void discard() { reusable = false; }
+
+        private:
+            friend class HttpConnectionPool;
+            Lease(HttpConnectionPool* pool, std::unique_ptr<httplib::Client> client);
+
+            HttpConnectionPool* pool;
+            std::unique_ptr<httplib::Client> client;
+            bool reusable = true;
+        };
+
+        HttpConnectionPool(std::string host, int port, size_t maxSize,
+                           std::chrono::seconds idleTimeout, std::chrono::seconds ioTimeout);
+        ~HttpConnectionPool();
+
+        HttpConnectionPool(const HttpConnectionPool&) = delete;
+        HttpConnectionPool& operator=(const HttpConnectionPool&) = delete;
+
+        Lease acquire();
+
+        HttpPoolStats stats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct IdleClient {
+            std::unique_ptr<httplib::Client> client;
+            Clock::time_point lastUsed;
+        };
+
+        std::unique_ptr<httplib::Client> createClient() const;
+        void release(std::unique_ptr<httplib::Client> client, bool reusable);
+
+        // Chiude le connessioni inattive scadute; richiede il lock
+        void evictExpired(Clock::time_point now);
+
+        std::string host;
+        int port;
+        size_t maxSize;
+        std::chrono::seconds idleTimeout;
+        std::chrono::seconds ioTimeout;
+
+        mutable std::mutex mutex;
+        std::condition_variable available;
+
+        // In coda le più recenti: la acquire riusa la connessione più "calda"
+        std::vector<IdleClient> idle;
+        size_t leased = 0;
+        HttpPoolStats counters;
+    };
+
+} // namespace stl2glb
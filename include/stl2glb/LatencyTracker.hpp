@@ -0,0 +1,67 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace stl2glb {
+
+/**
+ * @struct HedgeStats
+ * @brief Contatori delle GET duplicate (hedged) di un LatencyTracker
+ */
+    struct HedgeStats {
+        uint64_t requests = 0;   // GET osservate
+        uint64_t hedges = 0;     // Copie inviate
+        uint64_t hedgeWins = 0;  // Copie arrivate prima dell'originale
+        std::chrono::microseconds hedgeDelay{0};  // Soglia corrente (0 se non ancora calcolabile)
+    };
+
+/**
+ * @class LatencyTracker
+ * @brief Tempo alla prima risposta delle GET e soglia per le richieste duplicate
+ *
+ * Conserva gli ultimi WINDOW tempi fra invio della richiesta e arrivo degli
+ * header. Una GET ancora senza risposta oltre il percentile configurato viene
+ * duplicata su un'altra connessione ("hedged request"): la prima risposta
+ * vince e l'altra viene interrotta. Le copie sono limitate a una frazione
+ * delle richieste (HEDGE_BUDGET), così un rallentamento generale del cluster
+ * non raddoppia il carico.
+ */
+    class LatencyTracker {
+    public:
+        static constexpr size_t WINDOW = 256;
+        // Campioni necessari prima di inviare copie
+        static constexpr size_t MIN_SAMPLES = 20;
+        // Copie al massimo per richiesta osservata
+        static constexpr double HEDGE_BUDGET = 0.1;
+
+        // percentile in (0, 100); 0 disabilita le copie
+        explicit LatencyTracker(double percentile);
+
+        void record(std::chrono::microseconds firstByte);
+
+        // Ritardo oltre cui duplicare una nuova GET; vuoto se le copie sono disabilitate,
+        // i campioni sono ancora pochi o il budget è esaurito
+        std::optional<std::chrono::microseconds> hedgeDelay();
+
+        void hedgeSent();
+        void hedgeWon();
+
+        HedgeStats stats() const;
+
+    private:
+        std::chrono::microseconds percentileLocked() const;
+
+        const double percentile;
+        mutable std::mutex mutex;
+        std::vector<std::chrono::microseconds> samples;
+        size_t next = 0;
+        uint64_t requests = 0;
+        uint64_t hedges = 0;
+        uint64_t hedgeWins = 0;
+    };
+
+} // namespace stl2glb
@@ -0,0 +1,61 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "stl2glb/StorageBackend.hpp"
+
+namespace stl2glb {
+
+/**
+ * @class MemoryStorageBackend
+ * @brief StorageBackend in memoria, senza rete né disco per gli oggetti
+ *
+ * Pensato per benchmark e profilazione della conversione: il contenuto
+ * degli oggetti è condiviso e immutabile, quindi le letture copiano i byte
+ * fuori dal lock. Gli oggetti si perdono alla chiusura del processo.
+ */
+    class MemoryStorageBackend : public StorageBackend {
+    public:
+        const char* name() const override { return "memory"; }
+
+        void get(const std::string& bucket,
+                 const std::string& objectName,
+                 const std::string& localPath) override;
+
+        void getRange(const std::string& bucket,
+                      const std::string& objectName,
+                      uint64_t offset,
+                      uint64_t length,
+                      std::string& content) override;
+
+        void put(const std::string& bucket,
+                 const std::string& objectName,
+                 const std::string& localPath,
+                 const std::string& payloadSha256 = "") override;
+
+        bool head(const std::string& bucket,
+                  const std::string& objectName,
+                  uint64_t* size = nullptr) override;
+
+        bool getText(const std::string& bucket,
+                     const std::string& objectName,
+                     std::string& content) override;
+        void putText(const std::string& bucket,
+                     const std::string& objectName,
+                     const std::string& content) override;
+
+        // Numero di oggetti memorizzati
+        size_t size() const;
+
+    private:
+        using Object = std::shared_ptr<const std::string>;
+
+        // nullptr se l'oggetto non esiste
+        Object find(const std::string& bucket, const std::string& objectName) const;
+        void store(const std::string& bucket, const std::string& objectName, std::string content);
+
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Object> objects;
+    };
+
+} // namespace stl2glb
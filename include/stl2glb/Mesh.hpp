@@ -0,0 +1,171 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace stl2glb {
+
+/**
+ * @class AlignedBuffer
+ * @brief Array contiguo allineato a 64 byte che non inizializza gli elementi
+ *
+ * Sostituisce std::vector per i flussi di geometria: resize() non azzera
+ * la memoria, perché ogni elemento viene comunque sovrascritto dal produttore.
+ */
+    template <typename T>
+    class AlignedBuffer {
+        static_assert(std::is_trivially_copyable<T>::value, "AlignedBuffer requires trivially copyable types");
+
+    public:
+        static constexpr size_t ALIGNMENT = 64;
+
+        AlignedBuffer() = default;
+        explicit AlignedBuffer(size_t count) { resize(count); }
+
+        AlignedBuffer(AlignedBuffer&& other) noexcept
+                : ptr(std::move(other.ptr)), count(other.count), cap(other.cap) {
+            other.count = 0;
+            other.cap = 0;
+        }
+
+        AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+            ptr = std::move(other.ptr);
+            count = other.count;
+            cap = other.cap;
+            other.count = 0;
+            other.cap = 0;
+            return *this;
+        }
+
+        AlignedBuffer(const AlignedBuffer&) = delete;
+        AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+        void reserve(size_t capacity) {
+            if (capacity <= cap) return;
+
+            T* fresh = static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t(ALIGNMENT)));
+            if (count > 0) {
+                std::memcpy(fresh, ptr.get(), count * sizeof(T));
+            }
+            ptr.reset(fresh);
+            cap = capacity;
+        }
+
+        // Gli elementi aggiunti non vengono inizializzati; ridurre non rialloca
+        void resize(size_t newCount) {
+            reserve(newCount);
+            count = newCount;
+        }
+
+        // Accoda n elementi con crescita geometrica della capacità
+        void append(const T* values, size_t n) {
+            if (count + n > cap) {
+                reserve(std::max(count + n, cap + cap / 2));
+            }
+            std::memcpy(ptr.get() + count, values, n * sizeof(T));
+            count += n;
+        }
+
+        void clear() { count = 0; }
+
+        // Libera la memoria mantenendo l'oggetto riutilizzabile
+        void release() {
+            ptr.reset();
+            count = 0;
+            cap = 0;
+        }
+
+        T* data() { return ptr.get(); }
+        const T* data() const { return ptr.get(); }
+        size_t size() const { return count; }
+        size_t capacity() const { return cap; }
+        bool empty() const { return count == 0; }
+        size_t byteSize() const { return count * sizeof(T); }
+
+        T& operator[](size_t i) { return ptr.get()[i]; }
+        const T& operator[](size_t i) const { return ptr.get()[i]; }
+
+        T* begin() { return ptr.get(); }
+        T* end() { return ptr.get() + count; }
+        const T* begin() const { return ptr.get(); }
+        const T* end() const { return ptr.get() + count; }
+
+    private:
+        struct Deleter {
+            void operator()(T* p) const { ::operator delete(p, std::align_val_t(ALIGNMENT)); }
+        };
+
+        std::unique_ptr<T, Deleter> ptr;
+        size_t count = 0;
+        size_t cap = 0;
+    };
+
+/**
+ * @class Mesh
+ * @brief Geometria STL in forma structure-of-arrays, passata dal parser al writer
+ *
+ * Contiene un flusso di posizioni (tre vertici xyz per triangolo, 36 byte)
+ * e un flusso opzionale di normali per faccia (12 byte). Gli indici non sono
+ * prodotti dal parser: vengono costruiti solo dalla saldatura dei vertici
+ * nel writer, quando servono.
+ */
+    class Mesh {
+    public:
+        static constexpr size_t FLOATS_PER_TRIANGLE = 9;
+        static constexpr size_t FLOATS_PER_NORMAL = 3;
+
+        explicit Mesh(bool withNormals = true) : normalsEnabled(withNormals) {}
+
+        Mesh(Mesh&&) noexcept = default;
+        Mesh& operator=(Mesh&&) noexcept = default;
+
+        // Spazio per triangleCount triangoli, contenuto non inizializzato
+        void resize(size_t triangleCount) {
+            positionStream.resize(triangleCount * FLOATS_PER_TRIANGLE);
+            if (normalsEnabled) {
+                normalStream.resize(triangleCount * FLOATS_PER_NORMAL);
+            }
+            triangles = triangleCount;
+        }
+
+        size_t triangleCount() const { return triangles; }
+        bool empty() const { return triangles == 0; }
+        bool hasNormals() const { return normalsEnabled; }
+
+        // Posizioni del triangolo t: positions() + t * FLOATS_PER_TRIANGLE
+        float* positions() { return positionStream.data(); }
+        const float* positions() const { return positionStream.data(); }
+
+        // Normale del triangolo t: normals() + t * FLOATS_PER_NORMAL, nullptr se assenti
+        float* normals() { return normalsEnabled ? normalStream.data() : nullptr; }
+        const float* normals() const { return normalsEnabled ? normalStream.data() : nullptr; }
+
+        // Sposta i triangoli [from, from + count) in posizione to (compattazione in ordine)
+        void moveTriangles(size_t from, size_t to, size_t count) {
+            if (from == to || count == 0) return;
+            std::memmove(positionStream.data() + to * FLOATS_PER_TRIANGLE,
+                         positionStream.data() + from * FLOATS_PER_TRIANGLE,
+                         count * FLOATS_PER_TRIANGLE * sizeof(float));
+            if (normalsEnabled) {
+                std::memmove(normalStream.data() + to * FLOATS_PER_NORMAL,
+                             normalStream.data() + from * FLOATS_PER_NORMAL,
+                             count * FLOATS_PER_NORMAL * sizeof(float));
+            }
+        }
+
+        size_t memoryUsage() const {
+            return (positionStream.capacity() + normalStream.capacity()) * sizeof(float);
+        }
+
+    private:
+        AlignedBuffer<float> positionStream;
+        AlignedBuffer<float> normalStream;
+        size_t triangles = 0;
+        bool normalsEnabled = true;
+    };
+
+} // namespace stl2glb
@@ -1,5 +1,8 @@
 #pragma once
 #include <string>
+#include "stl2glb/AsyncS3Client.hpp"
+#include "stl2glb/EnvironmentHandler.hpp"
+#include "stl2glb/RetryPolicy.hpp"
 #include "stl2glb/SimpleMinioClient.hpp"
 
 namespace stl2glb {
@@ -9,7 +12,10 @@ namespace stl2glb {
  * @brief Adattatore per SimpleMinioClient che mantiene l'API originale
  *
  * Questa classe mantiene l'interfaccia originale di MinioClient
- * ma utilizza l'implementazione SimpleMinioClient sotto il cofano.
+ * ma utilizza l'istanza condivisa di SimpleMinioClient (e il suo pool
+ * di connessioni) sotto il cofano. Con async_io download e upload passano
+ * invece dall'event loop di AsyncS3Client (stream singolo, con le stesse
+ * ripetizioni di RetryPolicy).
  */
     class MinioClient {
     public:
@@ -24,7 +30,13 @@ namespace stl2glb {
         static void download(const std::string& bucket,
                              const std::string& objectName,
                              const std::string& localPath) {
-            SimpleMinioClient::download(bucket, objectName, localPath);
+            if (useAsyncIo()) {
+                asyncRetry().run("GET " + bucket + "/" + objectName, [&] {
+                    AsyncS3Client::instance().get(bucket, objectName, localPath).get();
+                });
+                return;
+            }
+            SimpleMinioClient::instance().download(bucket, objectName, localPath);
         }
 
         /**
@@ -33,18 +45,97 @@ namespace stl2glb {
          * @param bucket Nome del bucket su cui caricare
          * @param objectName Nome dell'oggetto da caricare
          * @param localPath Percorso locale del file da caricare
+         * @param payloadSha256 SHA-256 del file se già noto (ad esempio da GLBWriter); se vuoto
+         *        il corpo, inviato in streaming, non viene firmato (UNSIGNED-PAYLOAD)
          * @throws std::runtime_error in caso di errori di upload o file non trovato
          */
         static void upload(const std::string& bucket,
                            const std::string& objectName,
-                           const std::string& localPath) {
-            SimpleMinioClient::upload(bucket, objectName, localPath);
+                           const std::string& localPath,
+                           const std::string& payloadSha256 = "") {
+            if (useAsyncIo()) {
+                asyncRetry().run("PUT " + bucket + "/" + objectName, [&] {
+                    AsyncS3Client::instance().put(bucket, objectName, localPath, payloadSha256).get();
+                });
+                return;
+            }
+            SimpleMinioClient::instance().upload(bucket, objectName, localPath, payloadSha256);
+        }
+
+        /**
+         * @brief Legge un intervallo di un oggetto (GET con Range)
+         *
+         * @param offset Primo byte dell'intervallo
+         * @param length Byte richiesti; meno se l'oggetto termina prima
+         * @throws std::runtime_error in caso di errori di download o intervallo non valido
+         */
+        static void getRange(const std::string& bucket,
+                             const std::string& objectName,
+                             uint64_t offset,
+                             uint64_t length,
+                             std::string& content) {
+            SimpleMinioClient::instance().downloadRange(bucket, objectName, offset, length, content);
+        }
+
+        /**
+         * @brief Verifica se un oggetto esiste nel bucket (HEAD)
+         *
+         * @param size Se non nullo, riceve la dimensione dell'oggetto
+         * @return true se l'oggetto esiste; false se non esiste o la verifica non è riuscita
+         */
+        static bool exists(const std::string& bucket, const std::string& objectName, uint64_t* size = nullptr) {
+            return SimpleMinioClient::instance().objectExists(bucket, objectName, size);
+        }
+
+        /**
+         * @brief Legge un oggetto piccolo come stringa
+         *
+         * @return false se l'oggetto non esiste
+         * @throws std::runtime_error in caso di errori di connessione o di stato inatteso
+         */
+        static bool getText(const std::string& bucket,
+                            const std::string& objectName,
+                            std::string& content) {
+            return SimpleMinioClient::instance().getText(bucket, objectName, content);
+        }
+
+        /**
+         * @brief Scrive una stringa come oggetto
+         *
+         * @throws std::runtime_error in caso di errori di upload
+         */
+        static void putText(const std::string& bucket,
+                            const std::string& objectName,
+                            const std::string& content) {
+            SimpleMinioClient::instance().putText(bucket, objectName, content);
+        }
+
+        // Statistiche del pool di connessioni verso MinIO
+        static HttpPoolStats poolStats() {
+            return SimpleMinioClient::instance().poolStats();
+        }
+
+        // Statistiche delle GET duplicate (hedged)
+        static HedgeStats hedgeStats() {
+            return SimpleMinioClient::instance().hedgeStats();
         }
 
         // Non è possibile creare istanze dirette di questa classe
         MinioClient() = delete;
         MinioClient(const MinioClient&) = delete;
         MinioClient& operator=(const MinioClient&) = delete;
+
+    private:
+        static bool useAsyncIo() {
+            return EnvironmentHandler::instance().getMinioClientSettings().async_io;
+        }
+
+        static RetryPolicy& asyncRetry() {
+            const auto& settings = EnvironmentHandler::instance().getMinioClientSettings();
+            static RetryPolicy policy(settings.retry_count, std::chrono::milliseconds(settings.retry_base_ms),
+                                      std::chrono::milliseconds(settings.retry_max_ms));
+            return policy;
+        }
     };
 
 } // namespace stl2glb
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 
 namespace stl2glb {
@@ -14,11 +15,41 @@ namespace stl2glb {
         // Protocollo predefinito se non specificato nell'endpoint
         std::string default_protocol = "http";
 
-        // Numero di tentativi per le operazioni
+        // Ripetizioni dopo un errore transitorio (rete, 5xx, 429), con backoff
+        // esponenziale da retry_base_ms fino a retry_max_ms e jitter
         unsigned int retry_count = 3;
+        unsigned int retry_base_ms = 100;
+        unsigned int retry_max_ms = 5000;
 
-        // Timeout in secondi per le operazioni HTTP (se supportato dalla libreria)
+        // Timeout in secondi di connessione, lettura e scrittura di ogni richiesta HTTP
         unsigned int timeout_seconds = 30;
+
+        // Percentile del tempo di risposta oltre cui una GET viene duplicata
+        // su un'altra connessione; 0 disabilita
+        unsigned int hedge_percentile = 95;
+
+        // Connessioni keep-alive massime verso l'endpoint (conversioni parallele)
+        unsigned int pool_size = 8;
+
+        // Secondi dopo i quali una connessione inattiva viene chiusa
+        unsigned int pool_idle_seconds = 60;
+
+        // Download con GET a intervalli paralleli (Range) per oggetti di almeno
+        // parallel_download_min_bytes; sotto la soglia un unico stream
+        uint64_t download_part_bytes = 8ull * 1024 * 1024;
+        unsigned int download_concurrency = 4;
+        uint64_t parallel_download_min_bytes = 32ull * 1024 * 1024;
+
+        // Upload multipart a parti parallele per file di almeno multipart_min_bytes;
+        // sotto la soglia un unico PUT
+        uint64_t multipart_part_bytes = 16ull * 1024 * 1024;
+        unsigned int upload_concurrency = 4;
+        uint64_t multipart_min_bytes = 64ull * 1024 * 1024;
+
+        // Download e upload dei file tramite AsyncS3Client (event loop epoll su
+        // io_threads thread) invece del client sincrono
+        bool async_io = false;
+        unsigned int io_threads = 2;
     };
 
 } // namespace stl2glb
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace stl2glb {
+
+/**
+ * @class Parallel
+ * @brief Utilità minime per dividere un lavoro su più thread
+ */
+    class Parallel {
+    public:
+        /**
+         * @brief Numero di thread da usare per work unità di lavoro
+         *
+         * Non supera i core disponibili e garantisce almeno minWorkPerThread
+         * unità per thread, sotto la quale l'avvio dei thread non conviene.
+         */
+        static unsigned threadCount(size_t work, size_t minWorkPerThread) {
+            unsigned hw = std::thread::hardware_concurrency();
+            if (hw == 0) hw = 1;
+
+            size_t maxByWork = work / std::max<size_t>(1, minWorkPerThread);
+            return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(hw, maxByWork)));
+        }
+
+        /**
+         * @brief Esegue fn(t) per t in [0, numThreads) e propaga la prima eccezione
+         *
+         * Con un solo thread fn viene eseguita direttamente sul chiamante.
+         */
+        template <typename Fn>
+        static void run(size_t numThreads, Fn&& fn) {
+            if (numThreads <= 1) {
+                fn(size_t(0));
+                return;
+            }
+
+            std::vector<std::thread> workers;
+            std::vector<std::exception_ptr> errors(numThreads);
+            workers.reserve(numThreads);
+
+            for (size_t t = 0; t < numThreads; ++t) {
+                workers.emplace_back([t, &fn, &errors]() {
+                    try {
+                        fn(t);
+                    } catch (...) {
+                        errors[t] = std::current_exception();
+                    }
+                });
+            }
+
+            for (auto& worker : workers) {
+                worker.join();
+            }
+
+            for (const auto& error : errors) {
+                if (error) std::rethrow_exception(error);
+            }
+        }
+
+        // Intervallo [begin, end) del blocco t su numThreads blocchi di total elementi
+        static std::pair<size_t, size_t> blockRange(size_t t, size_t numThreads, size_t total) {
+            size_t perThread = (total + numThreads - 1) / numThreads;
+            size_t begin = std::min(t * perThread, total);
+            size_t end = std::min(begin + perThread, total);
+            return {begin, end};
+        }
+    };
+
+} // namespace stl2glb
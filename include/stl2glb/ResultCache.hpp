@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdio>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace stl2glb {
+
+/**
+ * @class ResultCache
+ * @brief Cache LRU thread-safe chiave di conversione -> glb_hash, persistente su disco
+ *
+ * Ogni inserimento viene accodato a un file indice di righe "chiave\\tvalore",
+ * riletto all'avvio (l'ultima riga per chiave vince). Quando il file supera il
+ * doppio della capacità viene riscritto con le sole voci presenti in memoria.
+ * Chiavi e valori non devono contenere tabulazioni o a capo.
+ */
+    class ResultCache {
+    public:
+        /**
+         * @param capacity Numero massimo di voci in memoria (0 disabilita la cache)
+         * @param indexPath File indice; vuoto per una cache solo in memoria
+         */
+        explicit ResultCache(size_t capacity, std::string indexPath = "");
+        ~ResultCache();
+
+        ResultCache(const ResultCache&) = delete;
+        ResultCache& operator=(const ResultCache&) = delete;
+
+        std::optional<std::string> lookup(const std::string& key);
+
+        void store(const std::string& key, const std::string& value);
+
+        size_t size() const;
+
+        bool enabled() const { return capacity > 0; }
+
+    private:
+        using Entry = std::pair<std::string, std::string>;
+
+        // Inserisce o aggiorna in memoria, con eventuale espulsione; richiede il lock
+        void insert(const std::string& key, const std::string& value);
+        void load();
+        void openIndex();
+        void compact();
+
+        size_t capacity;
+        std::string indexPath;
+        std::FILE* index = nullptr;
+        size_t indexLines = 0;
+
+        // Fronte della lista = voce usata più di recente
+        std::list<Entry> entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> positions;
+        mutable std::mutex mutex;
+    };
+
+} // namespace stl2glb
@@ -0,0 +1,69 @@
+#pragma once
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "stl2glb/Logger.hpp"
+
+namespace stl2glb {
+
+/**
+ * @class RetryableError
+ * @brief Errore transitorio (rete, 5xx, 429, 408): la richiesta può essere ripetuta
+ */
+    class RetryableError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+/**
+ * @class RetryPolicy
+ * @brief Ripetizione delle richieste S3 con backoff esponenziale limitato e jitter
+ *
+ * Solo RetryableError viene ritentato; ogni altra eccezione (404, 403, errori
+ * locali) arriva subito al chiamante. Prima del tentativo n+1 si attende un
+ * tempo casuale in [0, min(maxDelay, baseDelay * 2^n)] ("full jitter"): i
+ * client che falliscono insieme non ritentano insieme e il cluster in
+ * difficoltà non riceve raffiche sincronizzate.
+ */
+    class RetryPolicy {
+    public:
+        RetryPolicy(unsigned int retries,
+                    std::chrono::milliseconds baseDelay = std::chrono::milliseconds(100),
+                    std::chrono::milliseconds maxDelay = std::chrono::milliseconds(5000));
+
+        // Stati HTTP per cui ha senso ripetere la richiesta
+        static bool retryableStatus(int status);
+
+        // RetryableError per gli stati transitori, std::runtime_error per gli altri
+        [[noreturn]] static void throwForStatus(const std::string& message, int status);
+
+        // Attesa prima del tentativo successivo al tentativo attempt (da 0)
+        std::chrono::milliseconds backoff(unsigned int attempt) const;
+
+        unsigned int retries() const { return maxRetries; }
+
+        template <typename Fn>
+        auto run(const std::string& operation, Fn&& fn) -> decltype(fn()) {
+            for (unsigned int attempt = 0;; ++attempt) {
+                try {
+                    return fn();
+                } catch (const RetryableError& e) {
+                    if (attempt >= maxRetries) {
+                        throw;
+                    }
+                    auto delay = backoff(attempt);
+                    Logger::warn(operation + ": " + e.what() + ", retry " + std::to_string(attempt + 1) + "/" +
+                                 std::to_string(maxRetries) + " in " + std::to_string(delay.count()) + "ms");
+                    std::this_thread::sleep_for(delay);
+                }
+            }
+        }
+
+    private:
+        unsigned int maxRetries;
+        std::chrono::milliseconds baseDelay;
+        std::chrono::milliseconds maxDelay;
+    };
+
+} // namespace stl2glb
@@ -0,0 +1,45 @@
+#pragma once
+#include "stl2glb/StorageBackend.hpp"
+
+namespace stl2glb {
+
+/**
+ * @class S3StorageBackend
+ * @brief StorageBackend su MinIO / S3 tramite MinioClient
+ *
+ * Usa il client condiviso del processo: pool di connessioni, ripetizioni,
+ * GET duplicate, trasferimenti paralleli e, con STL2GLB_MINIO_IO=async,
+ * l'event loop di AsyncS3Client restano quelli configurati da EnvironmentHandler.
+ */
+    class S3StorageBackend : public StorageBackend {
+    public:
+        const char* name() const override { return "s3"; }
+
+        void get(const std::string& bucket,
+                 const std::string& objectName,
+                 const std::string& localPath) override;
+
+        void getRange(const std::string& bucket,
+                      const std::string& objectName,
+                      uint64_t offset,
+                      uint64_t length,
+                      std::string& content) override;
+
+        void put(const std::string& bucket,
+                 const std::string& objectName,
+                 const std::string& localPath,
+                 const std::string& payloadSha256 = "") override;
+
+        bool head(const std::string& bucket,
+                  const std::string& objectName,
+                  uint64_t* size = nullptr) override;
+
+        bool getText(const std::string& bucket,
+                     const std::string& objectName,
+                     std::string& content) override;
+        void putText(const std::string& bucket,
+                     const std::string& objectName,
+                     const std::string& content) override;
+    };
+
+} // namespace stl2glb
@@ -2,25 +2,12 @@
 #include <string>
 #include <vector>
 #include <cstdint>
-#include <cstring>
+#include "stl2glb/Mesh.hpp"
+#include "stl2glb/VertexWelder.hpp"
+#include "stl2glb/ConversionOptions.hpp"
 
 namespace stl2glb {
 
-    struct Triangle {
-        float normal[3];
-        float vertex1[3];
-        float vertex2[3];
-        float vertex3[3];
-        uint16_t attributeByteCount;
-
-        Triangle() : attributeByteCount(0) {
-            std::memset(normal, 0, sizeof(normal));
-            std::memset(vertex1, 0, sizeof(vertex1));
-            std::memset(vertex2, 0, sizeof(vertex2));
-            std::memset(vertex3, 0, sizeof(vertex3));
-        }
-    };
-
 #pragma pack(push, 1)
     struct STLTriangleRaw {
         float normal[3];
@@ -32,4 +19,31 @@ namespace stl2glb {
 #pragma pack(pop)
 
     static_assert(sizeof(STLTriangleRaw) == 50, "STLTriangleRaw must be exactly 50 bytes");
+
+    class STLParser {
+    public:
+        /**
+         * @brief Legge un file STL binario o ASCII
+         *
+         * Il formato viene riconosciuto dal contenuto: la dimensione esatta
+         * del formato binario ha la precedenza su un header che inizia con "solid".
+         *
+         * @param path Percorso del file STL
+         * @return Mesh Triangoli validi con normali corrette, in ordine di file
+         * @throws std::runtime_error se il file non è leggibile o è malformato
+         */
+        static Mesh parse(const std::string& path);
+
+        /**
+         * @brief Legge il file STL e salda i vertici secondo options
+         *
+         * Per i file binari con saldatura esatta e options.fusedParse i record
+         * vengono validati a blocchi e saldati subito, mentre il file mappato
+         * viene letto in sequenza: la Mesh completa non viene mai allocata.
+         * Negli altri casi equivale a parse() seguito da VertexWelder::weld().
+         *
+         * @throws std::runtime_error se il file non è leggibile o è malformato
+         */
+        static IndexedMesh parseWelded(const std::string& path, const ConversionOptions& options = {});
+    };
 }
@@ -5,49 +5,185 @@
 #include <filesystem>
 #include <fstream>
 #include <httplib.h>
-#include <openssl/hmac.h>
-#include <openssl/evp.h>
+#include "stl2glb/AwsV4Signer.hpp"
+#include "stl2glb/HttpConnectionPool.hpp"
+#include "stl2glb/LatencyTracker.hpp"
 #include "stl2glb/Logger.hpp"
+#include "stl2glb/Mesh.hpp"
+#include "stl2glb/MinioClientConfig.hpp"
+#include "stl2glb/RetryPolicy.hpp"
+#include <functional>
 #include <vector>
 
 namespace stl2glb {
 
+/**
+ * @class SimpleMinioClient
+ * @brief Client S3 minimale (firma AWS V4) con pool di connessioni keep-alive
+ *
+ * Ogni istanza mantiene un HttpConnectionPool verso il proprio endpoint: le
+ * operazioni prendono in prestito una connessione e la restituiscono al
+ * termine, quindi conversioni parallele riusano le connessioni già aperte
+ * invece di aprirne (e negoziarne) una nuova per ogni oggetto. Ogni richiesta
+ * passa da RetryPolicy (errori transitori ripetuti con backoff e jitter) e le
+ * GET più lente del percentile configurato vengono duplicate su un'altra
+ * connessione (LatencyTracker).
+ */
     class SimpleMinioClient {
+    public:
+        // Valore di x-amz-content-sha256 per un corpo non firmato
+        static constexpr const char* UNSIGNED_PAYLOAD = "UNSIGNED-PAYLOAD";
+
+        // Dimensione dei blocchi letti dal file durante l'upload
+        static constexpr size_t UPLOAD_BLOCK_SIZE = 1024 * 1024;
+
+        // Limiti S3 per l'upload multipart: parti di almeno 5 MB (tranne l'ultima), al massimo 10000
+        static constexpr uint64_t MIN_MULTIPART_PART_SIZE = 5ull * 1024 * 1024;
+        static constexpr uint64_t MAX_MULTIPART_PARTS = 10000;
+
     private:
-        static std::string endpoint;
-        static std::string accessKey;
-        static std::string secretKey;
-        static std::mutex clientMutex;
-        static bool initialized;
+        std::string endpoint;
+        std::string accessKey;
+        std::string secretKey;
+        MinioClientSettings settings;
+        std::string hostHeader;
+        AwsV4Signer signer;
+        HttpConnectionPool pool;
+        RetryPolicy retry;
+        LatencyTracker latency;
 
-        static void initialize();
+        struct GetRace;
 
         // Helper functions for AWS Signature V4
         static std::string urlEncode(const std::string& value, bool encodeSlash = true);
         static std::string sha256(const std::string& data);
-        static std::string hmacSha256(const std::string& key, const std::string& data);
-        static std::vector<unsigned char> hmacSha256Raw(const std::string& key, const std::string& data);
-        static std::string getAmzDate();
-        static std::string getDateStamp();
-        static httplib::Headers createAwsV4Headers(
+        httplib::Headers createAwsV4Headers(
                 const std::string& method,
                 const std::string& path,
                 const std::string& payload,
-                const std::string& contentType = ""
-        );
+                const std::string& contentType = "",
+                const std::string& knownPayloadHash = "",
+                const std::string& canonicalQuery = ""
+        ) const;
+
+        // GET in streaming con ripetizione e copia (hedge) della richiesta lenta.
+        // onStart(Content-Length, 0 se assente) apre ogni tentativo e deve azzerare
+        // la destinazione; poi onData per ogni blocco ricevuto
+        void getStreaming(const std::string& path,
+                          const httplib::Headers& extraHeaders,
+                          const std::function<void(uint64_t)>& onStart,
+                          const httplib::ContentReceiver& onData,
+                          int expectedStatus = 200);
+        // Un tentativo: la GET e, se tarda oltre la soglia di LatencyTracker, la sua copia
+        void hedgedGet(const std::string& path,
+                       const httplib::Headers& extraHeaders,
+                       const std::function<void(uint64_t)>& onStart,
+                       const httplib::ContentReceiver& onData,
+                       int expectedStatus);
+        // Una delle due richieste in gara; l'esito va in race.errors[attempt]
+        void getAttempt(GetRace& race,
+                        int attempt,
+                        const std::string& path,
+                        const httplib::Headers& extraHeaders,
+                        const std::function<void(uint64_t)>& onStart,
+                        const httplib::ContentReceiver& onData,
+                        int expectedStatus);
+        // HEAD con ripetizione: stato HTTP e, se 200 e size non nullo, Content-Length
+        int headObject(const std::string& path, uint64_t* size);
+
+        // Scrive length byte ricevuti all'offset indicato; chiamata da più thread su intervalli disgiunti
+        using RangeSink = std::function<bool(uint64_t offset, const char* data, size_t length)>;
+
+        // HEAD sull'oggetto: true (con size) se va scaricato a intervalli paralleli,
+        // false per oggetti piccoli, download parallelo disabilitato o HEAD fallita
+        bool parallelDownloadSize(const std::string& path, uint64_t& size);
+        // GET con Range di download_part_bytes su download_concurrency connessioni del pool
+        void getRanges(const std::string& path, uint64_t size, const RangeSink& sink);
+
+        // Upload multipart: initiate, parti in parallelo su upload_concurrency connessioni
+        // (ognuna ritentata fino a retry_count volte), complete; abort in caso di errore
+        void multipartUpload(const std::string& path,
+                             const std::string& localPath,
+                             uint64_t fileSize,
+                             const std::string& contentType);
+        std::string initiateMultipart(const std::string& path, const std::string& contentType);
+        // Restituisce l'ETag della parte
+        std::string uploadPart(const std::string& path,
+                               const std::string& uploadId,
+                               unsigned int partNumber,
+                               std::ifstream& in,
+                               uint64_t offset,
+                               uint64_t length,
+                               std::vector<char>& buffer);
+        void completeMultipart(const std::string& path,
+                               const std::string& uploadId,
+                               const std::vector<std::string>& etags);
+        // Non lancia eccezioni: un abort fallito viene solo registrato
+        void abortMultipart(const std::string& path, const std::string& uploadId);
 
         static void ensureDirectoryExists(const std::string& filePath);
-        static bool ensureBucketExists(const std::string& bucketName);
-        static bool createBucket(const std::string& bucketName);
+        bool ensureBucketExists(const std::string& bucketName);
+        bool createBucket(const std::string& bucketName);
 
     public:
-        static void download(const std::string& bucket,
-                             const std::string& objectName,
-                             const std::string& localPath);
+        SimpleMinioClient(const std::string& endpoint,
+                          const std::string& accessKey,
+                          const std::string& secretKey,
+                          const MinioClientSettings& settings = {});
+
+        SimpleMinioClient(const SimpleMinioClient&) = delete;
+        SimpleMinioClient& operator=(const SimpleMinioClient&) = delete;
 
-        static void upload(const std::string& bucket,
+        // Client condiviso del processo, configurato da EnvironmentHandler alla prima chiamata
+        static SimpleMinioClient& instance();
+
+        // Endpoint con protocollo ("http://" se assente), host e porta (80 se assente)
+        static std::string normalizeEndpoint(const std::string& endpoint);
+        static std::string endpointHost(const std::string& endpoint);
+        static int endpointPort(const std::string& endpoint);
+
+        // Il corpo viene scritto a blocchi direttamente nel file, preallocato da Content-Length;
+        // oggetti di almeno parallel_download_min_bytes sono scaricati a intervalli paralleli
+        void download(const std::string& bucket,
+                      const std::string& objectName,
+                      const std::string& localPath);
+
+        // Scarica l'oggetto in un buffer dimensionato da Content-Length, senza copie intermedie
+        void downloadToBuffer(const std::string& bucket,
+                              const std::string& objectName,
+                              AlignedBuffer<char>& buffer);
+
+        // Il file viene inviato in streaming a blocchi di UPLOAD_BLOCK_SIZE; da
+        // multipart_min_bytes in su come upload multipart a parti parallele.
+        // payloadSha256: SHA-256 esadecimale del file se già noto, usato per firmare
+        // il corpo; se vuoto il corpo viene inviato come UNSIGNED-PAYLOAD
+        void upload(const std::string& bucket,
+                    const std::string& objectName,
+                    const std::string& localPath,
+                    const std::string& payloadSha256 = "");
+
+        // Intervallo [offset, offset + length) dell'oggetto con una GET Range, troncato alla fine dell'oggetto
+        void downloadRange(const std::string& bucket,
                            const std::string& objectName,
-                           const std::string& localPath);
+                           uint64_t offset,
+                           uint64_t length,
+                           std::string& content);
+
+        // HEAD sull'oggetto: true se esiste (con la dimensione in size, se non nullo);
+        // in caso di errore restituisce false (il chiamante procede)
+        bool objectExists(const std::string& bucket, const std::string& objectName, uint64_t* size = nullptr);
+
+        // Oggetti piccoli in memoria (es. indici); getText restituisce false se l'oggetto non esiste
+        bool getText(const std::string& bucket,
+                     const std::string& objectName,
+                     std::string& content);
+        void putText(const std::string& bucket,
+                     const std::string& objectName,
+                     const std::string& content,
+                     const std::string& contentType = "text/plain");
+
+        HttpPoolStats poolStats() const;
+        HedgeStats hedgeStats() const;
     };
 
-} // namespace stl2glb
\ No newline at end of file
+} // namespace stl2glb
@@ -0,0 +1,35 @@
+#pragma once
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace stl2glb {
+
+/**
+ * @class SingleFlight
+ * @brief Deduplica le esecuzioni concorrenti con la stessa chiave
+ *
+ * La prima chiamata per una chiave esegue la funzione; le chiamate che arrivano
+ * mentre è in corso ne attendono il risultato invece di ripetere il lavoro.
+ * Un'eccezione viene rilanciata a tutti i chiamanti che la stavano attendendo.
+ * Terminata l'esecuzione la chiave viene rimossa: le chiamate successive
+ * eseguono di nuovo la funzione.
+ */
+    class SingleFlight {
+    public:
+        /**
+         * @param shared Se non nullo, indica se il risultato è stato preso da un'esecuzione già in corso
+         */
+        std::string run(const std::string& key, const std::function<std::string()>& fn, bool* shared = nullptr);
+
+        // Numero di chiavi con un'esecuzione in corso
+        size_t inFlight() const;
+
+    private:
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, std::shared_future<std::string>> calls;
+    };
+
+} // namespace stl2glb
@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "stl2glb/Mesh.hpp"
+
+namespace stl2glb {
+
+/**
+ * @class SpatialWeldGrid
+ * @brief Griglia spaziale uniforme per la saldatura dei vertici entro una tolleranza
+ *
+ * Le celle hanno lato almeno pari alla tolleranza, quindi un vertice entro
+ * tolleranza si trova sempre nella cella del punto o in una delle 26 vicine.
+ * Il lato viene aumentato quando serve perché le coordinate di cella del
+ * bounding box stiano in 21 bit e formino una chiave a 64 bit. Solo le celle
+ * occupate sono memorizzate, in una tabella hash a indirizzamento aperto;
+ * i vertici di una cella sono concatenati in una lista.
+ */
+    class SpatialWeldGrid {
+    public:
+        static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+
+        /**
+         * @param minBounds, maxBounds Bounding box di tutte le posizioni da inserire
+         * @param tolerance Distanza massima tra due vertici saldati (> 0)
+         * @param expectedVertices Stima dei vertici unici, per il dimensionamento iniziale
+         */
+        SpatialWeldGrid(const std::array<float, 3>& minBounds, const std::array<float, 3>& maxBounds,
+                        float tolerance, size_t expectedVertices)
+                : origin(minBounds), toleranceSquared(tolerance * tolerance) {
+            float extent = 0.0f;
+            for (int k = 0; k < 3; ++k) {
+                extent = std::max(extent, maxBounds[k] - minBounds[k]);
+            }
+            cellSize = std::max(tolerance, extent / static_cast<float>(MAX_CELL_COORD));
+            inverseCellSize = 1.0f / cellSize;
+
+            size_t capacity = MIN_CAPACITY;
+            while (capacity * MAX_LOAD_NUM < expectedVertices * MAX_LOAD_DEN) {
+                capacity <<= 1;
+            }
+            allocate(capacity);
+            points.reserve(expectedVertices);
+        }
+
+        /**
+         * @brief Cerca un vertice entro tolleranza e, se assente, inserisce position con indice candidate
+         *
+         * A parità di distanza vince il vertice inserito per primo, così il risultato
+         * dipende solo dall'ordine di inserimento.
+         *
+         * @return uint32_t Indice del vertice: candidate se appena inserito
+         */
+        uint32_t findOrInsert(const float* position, uint32_t candidate) {
+            int64_t cell[3];
+            for (int k = 0; k < 3; ++k) {
+                cell[k] = cellCoord(position[k], k);
+            }
+
+            uint32_t best = EMPTY;
+            float bestDistance = toleranceSquared;
+            for (int64_t dx = -1; dx <= 1; ++dx) {
+                for (int64_t dy = -1; dy <= 1; ++dy) {
+                    for (int64_t dz = -1; dz <= 1; ++dz) {
+                        int64_t x = cell[0] + dx, y = cell[1] + dy, z = cell[2] + dz;
+                        if (x < 0 || y < 0 || z < 0 ||
+                            x > MAX_CELL_COORD || y > MAX_CELL_COORD || z > MAX_CELL_COORD) {
+                            continue;
+                        }
+
+                        const Cell* c = findCell(packCell(x, y, z));
+                        if (!c) continue;
+
+                        for (uint32_t p = c->head; p != EMPTY; p = points[p].next) {
+                            const Point& point = points[p];
+                            float ex = point.position[0] - position[0];
+                            float ey = point.position[1] - position[1];
+                            float ez = point.position[2] - position[2];
+                            float d = ex * ex + ey * ey + ez * ez;
+                            if (d < bestDistance || (d == bestDistance && (best == EMPTY || p < best))) {
+                                best = p;
+                                bestDistance = d;
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (best != EMPTY) {
+                return points[best].value;
+            }
+
+            // Nuovo vertice in testa alla lista della sua cella
+            Cell& c = findOrInsertCell(packCell(cell[0], cell[1], cell[2]));
+            uint32_t id = static_cast<uint32_t>(points.size());
+            Point point{{position[0], position[1], position[2]}, c.head, candidate};
+            points.append(&point, 1);
+            c.head = id;
+            return candidate;
+        }
+
+        size_t size() const { return points.size(); }
+        float cellLength() const { return cellSize; }
+
+    private:
+        // Coordinate di cella su 21 bit per asse
+        static constexpr int64_t MAX_CELL_COORD = (int64_t(1) << 21) - 1;
+
+        static constexpr size_t MAX_LOAD_NUM = 7;
+        static constexpr size_t MAX_LOAD_DEN = 10;
+        static constexpr size_t MIN_CAPACITY = 1024;
+        static constexpr uint64_t EMPTY_KEY = ~uint64_t(0);
+
+        struct Point {
+            float position[3];
+            uint32_t next;   // Vertice successivo nella stessa cella
+            uint32_t value;  // Indice restituito al chiamante
+        };
+
+        struct Cell {
+            uint64_t key;
+            uint32_t head;
+        };
+
+        int64_t cellCoord(float v, int axis) const {
+            float c = std::floor((v - origin[axis]) * inverseCellSize);
+            return std::min<int64_t>(MAX_CELL_COORD, std::max<int64_t>(0, static_cast<int64_t>(c)));
+        }
+
+        static uint64_t packCell(int64_t x, int64_t y, int64_t z) {
+            return static_cast<uint64_t>(x) | (static_cast<uint64_t>(y) << 21) | (static_cast<uint64_t>(z) << 42);
+        }
+
+        static size_t hash(uint64_t key) {
+            key ^= key >> 33;
+            key *= 0xFF51AFD7ED558CCDull;
+            key ^= key >> 33;
+            key *= 0xC4CEB9FE1A85EC53ull;
+            key ^= key >> 33;
+            return static_cast<size_t>(key);
+        }
+
+        const Cell* findCell(uint64_t key) const {
+            size_t slot = hash(key) & mask;
+            while (cells[slot].key != EMPTY_KEY) {
+                if (cells[slot].key == key) return &cells[slot];
+                slot = (slot + 1) & mask;
+            }
+            return nullptr;
+        }
+
+        Cell& findOrInsertCell(uint64_t key) {
+            if ((cellCount + 1) * MAX_LOAD_DEN > cells.size() * MAX_LOAD_NUM) {
+                grow();
+            }
+
+            size_t slot = hash(key) & mask;
+            while (cells[slot].key != EMPTY_KEY) {
+                if (cells[slot].key == key) return cells[slot];
+                slot = (slot + 1) & mask;
+            }
+            cells[slot] = Cell{key, EMPTY};
+            ++cellCount;
+            return cells[slot];
+        }
+
+        void allocate(size_t capacity) {
+            cells.release();
+            cells.resize(capacity);
+            for (auto& c : cells) {
+                c.key = EMPTY_KEY;
+            }
+            mask = capacity - 1;
+            cellCount = 0;
+        }
+
+        void grow() {
+            AlignedBuffer<Cell> old = std::move(cells);
+            allocate(old.size() * 2);
+
+            for (const auto& c : old) {
+                if (c.key == EMPTY_KEY) continue;
+
+                size_t slot = hash(c.key) & mask;
+                while (cells[slot].key != EMPTY_KEY) {
+                    slot = (slot + 1) & mask;
+                }
+                cells[slot] = c;
+                ++cellCount;
+            }
+        }
+
+        std::array<float, 3> origin;
+        float toleranceSquared;
+        float cellSize = 0.0f;
+        float inverseCellSize = 0.0f;
+
+        AlignedBuffer<Cell> cells;
+        AlignedBuffer<Point> points;
+        size_t mask = 0;
+        size_t cellCount = 0;
+    };
+
+} // namespace stl2glb
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace stl2glb {
+
+/**
+ * @enum StorageType
+ * @brief Archivio degli oggetti STL e GLB scelto con STL2GLB_STORAGE
+ */
+    enum class StorageType {
+        S3,          // MinIO / S3 tramite SimpleMinioClient (firma AWS V4)
+        FileSystem,  // Directory locale: <radice>/<bucket>/<oggetto>
+        Memory       // Mappa in memoria del processo (benchmark, profilazione)
+    };
+
+/**
+ * @class StorageBackend
+ * @brief Interfaccia dell'archivio di oggetti usato da Converter e Server
+ *
+ * Gli oggetti sono identificati da bucket e nome come in S3; le implementazioni
+ * devono essere utilizzabili da più thread contemporaneamente. Gli errori
+ * vengono segnalati con std::runtime_error, tranne head che come
+ * MinioClient::exists restituisce false quando la verifica non riesce.
+ */
+    class StorageBackend {
+    public:
+        virtual ~StorageBackend() = default;
+
+        // Nome del backend per log e /stats ("s3", "filesystem", "memory")
+        virtual const char* name() const = 0;
+
+        // Scrive l'oggetto nel file locale, sovrascrivendolo
+        virtual void get(const std::string& bucket,
+                         const std::string& objectName,
+                         const std::string& localPath) = 0;
+
+        // Legge fino a length byte dall'offset indicato (meno se l'oggetto finisce prima);
+        // un offset oltre la fine dell'oggetto è un errore
+        virtual void getRange(const std::string& bucket,
+                              const std::string& objectName,
+                              uint64_t offset,
+                              uint64_t length,
+                              std::string& content) = 0;
+
+        // Carica il file locale come oggetto; payloadSha256 (se noto) è usato solo da S3
+        virtual void put(const std::string& bucket,
+                         const std::string& objectName,
+                         const std::string& localPath,
+                         const std::string& payloadSha256 = "") = 0;
+
+        // true se l'oggetto esiste; se size non è nullo vi scrive la dimensione
+        virtual bool head(const std::string& bucket,
+                          const std::string& objectName,
+                          uint64_t* size = nullptr) = 0;
+
+        // Oggetti piccoli in memoria (es. indici); getText restituisce false se l'oggetto non esiste
+        virtual bool getText(const std::string& bucket,
+                             const std::string& objectName,
+                             std::string& content) = 0;
+        virtual void putText(const std::string& bucket,
+                             const std::string& objectName,
+                             const std::string& content) = 0;
+
+        // Backend del processo, scelto da EnvironmentHandler alla prima chiamata
+        static StorageBackend& instance();
+
+        static std::unique_ptr<StorageBackend> create(StorageType type, const std::string& root = "");
+
+        static StorageType typeFromString(const std::string& name) {
+            if (name == "s3") return StorageType::S3;
+            if (name == "filesystem") return StorageType::FileSystem;
+            if (name == "memory") return StorageType::Memory;
+            throw std::runtime_error("Unknown storage backend: " + name);
+        }
+
+        static const char* typeName(StorageType type) {
+            switch (type) {
+                case StorageType::FileSystem: return "filesystem";
+                case StorageType::Memory: return "memory";
+                default: return "s3";
+            }
+        }
+    };
+
+} // namespace stl2glb
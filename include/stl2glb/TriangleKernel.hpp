@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "stl2glb/STLParser.hpp"
+#include "stl2glb/Mesh.hpp"
+
+namespace stl2glb {
+
+/**
+ * @class TriangleKernel
+ * @brief Validazione e correzione delle normali a blocchi sui record STL grezzi
+ *
+ * Elabora i record binari da 50 byte a gruppi di 4, 8 o 16 triangoli
+ * (SSE4.2, AVX2, AVX-512) con dispatch a runtime e fallback scalare.
+ * Tutte le varianti eseguono le stesse operazioni IEEE nello stesso ordine,
+ * quindi il risultato è identico bit a bit a quello scalare.
+ */
+    class TriangleKernel {
+    public:
+        enum class Isa {
+            Scalar,
+            SSE42,
+            AVX2,
+            AVX512
+        };
+
+        /**
+         * @brief Restituisce il set di istruzioni migliore supportato dalla CPU
+         */
+        static Isa detectIsa();
+
+        static const char* isaName(Isa isa);
+
+        /**
+         * @brief Valida i record e scrive i triangoli validi con normale corretta
+         *
+         * L'output segue il layout di Mesh: 9 float di posizione e 3 di normale
+         * per ogni triangolo valido, compattati in ordine.
+         *
+         * @param records Puntatore al primo record STL da 50 byte
+         * @param count Numero di record da elaborare
+         * @param positions Destinazione delle posizioni, almeno count * 9 float
+         * @param normals Destinazione delle normali (count * 3 float), oppure nullptr
+         * @param rejected Riceve gli indici (firstIndex + i) dei record scartati, in ordine
+         * @param firstIndex Indice globale del primo record, usato per rejected
+         * @return size_t Numero di triangoli validi scritti
+         */
+        static size_t process(const uint8_t* records, size_t count, float* positions, float* normals,
+                              std::vector<uint32_t>& rejected, uint32_t firstIndex = 0);
+
+        /**
+         * @brief Come process(), ma forza un set di istruzioni specifico
+         *
+         * Usato dai benchmark; l'ISA deve essere supportato dalla CPU corrente.
+         */
+        static size_t process(Isa isa, const uint8_t* records, size_t count, float* positions, float* normals,
+                              std::vector<uint32_t>& rejected, uint32_t firstIndex = 0);
+    };
+
+} // namespace stl2glb
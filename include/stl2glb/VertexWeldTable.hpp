@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "stl2glb/Mesh.hpp"
+
+namespace stl2glb {
+
+/**
+ * @class VertexWeldTable
+ * @brief Tabella hash a indirizzamento aperto per la saldatura esatta dei vertici
+ *
+ * Le chiavi sono i bit delle tre coordinate float (con -0 normalizzato a +0,
+ * come nel confronto tra float) e i valori sono gli indici dei vertici unici.
+ * Gli slot sono in un unico array contiguo con probing lineare: nessuna
+ * allocazione per vertice e al massimo un paio di cache miss per lookup.
+ */
+    class VertexWeldTable {
+    public:
+        static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+
+        /**
+         * @param expectedVertices Stima dei vertici unici, usata per il dimensionamento iniziale
+         */
+        explicit VertexWeldTable(size_t expectedVertices) {
+            size_t capacity = MIN_CAPACITY;
+            while (capacity * MAX_LOAD_NUM < expectedVertices * MAX_LOAD_DEN) {
+                capacity <<= 1;
+            }
+            allocate(capacity);
+        }
+
+        /**
+         * @brief Cerca la posizione e, se assente, la inserisce con indice candidate
+         *
+         * @return uint32_t Indice del vertice: candidate se appena inserito
+         */
+        uint32_t findOrInsert(const float* position, uint32_t candidate) {
+            if ((count + 1) * MAX_LOAD_DEN > slots.size() * MAX_LOAD_NUM) {
+                grow();
+            }
+
+            Key key = makeKey(position);
+            size_t slot = hash(key) & mask;
+            while (true) {
+                Slot& s = slots[slot];
+                if (s.value == EMPTY) {
+                    s.key[0] = key.bits[0];
+                    s.key[1] = key.bits[1];
+                    s.key[2] = key.bits[2];
+                    s.value = candidate;
+                    ++count;
+                    return candidate;
+                }
+                if (s.key[0] == key.bits[0] && s.key[1] == key.bits[1] && s.key[2] == key.bits[2]) {
+                    return s.value;
+                }
+                slot = (slot + 1) & mask;
+            }
+        }
+
+        size_t size() const { return count; }
+        size_t capacity() const { return slots.size(); }
+
+    private:
+        // Fattore di carico massimo 7/10
+        static constexpr size_t MAX_LOAD_NUM = 7;
+        static constexpr size_t MAX_LOAD_DEN = 10;
+        static constexpr size_t MIN_CAPACITY = 1024;
+
+        struct Key {
+            uint32_t bits[3];
+        };
+
+        struct Slot {
+            uint32_t key[3];
+            uint32_t value;
+        };
+
+        static Key makeKey(const float* position) {
+            Key key;
+            for (int i = 0; i < 3; ++i) {
+                // -0.0f == 0.0f: stessa chiave, come con il confronto tra float
+                float v = position[i] == 0.0f ? 0.0f : position[i];
+                std::memcpy(&key.bits[i], &v, sizeof(uint32_t));
+            }
+            return key;
+        }
+
+        static size_t hash(const Key& key) {
+            uint64_t h = (static_cast<uint64_t>(key.bits[0]) | (static_cast<uint64_t>(key.bits[1]) << 32)) *
+                         0x9E3779B97F4A7C15ull;
+            h ^= static_cast<uint64_t>(key.bits[2]) * 0xC2B2AE3D27D4EB4Full;
+            h ^= h >> 29;
+            h *= 0xBF58476D1CE4E5B9ull;
+            h ^= h >> 32;
+            return static_cast<size_t>(h);
+        }
+
+        void allocate(size_t capacity) {
+            slots.release();
+            slots.resize(capacity);
+            for (auto& s : slots) {
+                s.value = EMPTY;
+            }
+            mask = capacity - 1;
+            count = 0;
+        }
+
+        void grow() {
+            AlignedBuffer<Slot> old = std::move(slots);
+            allocate(old.size() * 2);
+
+            for (const auto& s : old) {
+                if (s.value == EMPTY) continue;
+
+                Key key{{s.key[0], s.key[1], s.key[2]}};
+                size_t slot = hash(key) & mask;
+                while (slots[slot].value != EMPTY) {
+                    slot = (slot + 1) & mask;
+                }
+                slots[slot] = s;
+                ++count;
+            }
+        }
+
+        AlignedBuffer<Slot> slots;
+        size_t mask = 0;
+        size_t count = 0;
+    };
+
+} // namespace stl2glb
@@ -0,0 +1,106 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "stl2glb/Mesh.hpp"
+#include "stl2glb/ConversionOptions.hpp"
+#include "stl2glb/VertexWeldTable.hpp"
+#include "stl2glb/SpatialWeldGrid.hpp"
+
+namespace stl2glb {
+
+/**
+ * @struct IndexedMesh
+ * @brief Risultato della saldatura: vertici unici, normali per vertice e indici
+ */
+    struct IndexedMesh {
+        AlignedBuffer<float> vertices;   // xyz per vertice unico
+        AlignedBuffer<float> normals;    // xyz per vertice, vuoto se la Mesh non ha normali
+        AlignedBuffer<uint32_t> indices; // tre indici per triangolo
+        std::array<float, 3> minBounds = {0.0f, 0.0f, 0.0f};
+        std::array<float, 3> maxBounds = {0.0f, 0.0f, 0.0f};
+
+        size_t vertexCount() const { return vertices.size() / 3; }
+        size_t triangleCount() const { return indices.size() / 3; }
+    };
+
+/**
+ * @class WeldAccumulator
+ * @brief Saldatura incrementale: riceve i triangoli a blocchi e costruisce l'IndexedMesh
+ *
+ * Permette al parser di saldare mentre legge il file, senza materializzare
+ * la Mesh completa. Il risultato è lo stesso della saldatura sequenziale
+ * sulla Mesh con gli stessi triangoli nello stesso ordine.
+ */
+    class WeldAccumulator {
+    public:
+        // Saldatura esatta con VertexWeldTable
+        WeldAccumulator(size_t expectedTriangles, bool withNormals);
+
+        // Saldatura entro tolerance: la griglia richiede in anticipo il bounding box dell'input
+        WeldAccumulator(size_t expectedTriangles, bool withNormals, const std::array<float, 3>& minBounds,
+                        const std::array<float, 3>& maxBounds, float tolerance);
+
+        /**
+         * @param positions 9 float per triangolo, layout di Mesh
+         * @param normals 3 float per triangolo, oppure nullptr se l'accumulatore è senza normali
+         */
+        void addTriangles(const float* positions, const float* normals, size_t count);
+
+        // Calcola i bounds e restituisce il risultato; l'accumulatore non va più usato
+        IndexedMesh finish();
+
+    private:
+        IndexedMesh out;
+        std::optional<VertexWeldTable> exactTable;
+        std::optional<SpatialWeldGrid> grid;
+        bool withNormals;
+        float tolerance = 0.0f;
+        size_t degenerate = 0;
+    };
+
+/**
+ * @class VertexWelder
+ * @brief Saldatura dei vertici coincidenti di una Mesh
+ *
+ * I vertici unici sono numerati in ordine di prima occorrenza e ognuno
+ * prende la normale del triangolo che lo ha introdotto. Le due varianti
+ * esatte producono esattamente lo stesso output, quindi lo stesso GLB e lo stesso hash.
+ */
+    class VertexWelder {
+    public:
+        /**
+         * @brief Salda secondo options.weldMode
+         *
+         * In modalità esatta sceglie la variante parallela per le mesh molto grandi.
+         */
+        static IndexedMesh weld(const Mesh& mesh, const ConversionOptions& options = {});
+
+        // Un solo thread con VertexWeldTable
+        static IndexedMesh weldSequential(const Mesh& mesh);
+
+        /**
+         * @brief Saldatura su tutti i core tramite radix sort delle chiavi di posizione
+         *
+         * Ordina le chiavi a 96 bit dei 3·N angoli insieme all'indice dell'angolo
+         * (radix sort LSD stabile), assegna gli id dei vertici con una scansione
+         * prefissa in ordine di angolo e scrive il buffer degli indici.
+         *
+         * @param numThreads Numero di thread, 0 per usare tutti i core
+         */
+        static IndexedMesh weldParallel(const Mesh& mesh, unsigned numThreads = 0);
+
+        /**
+         * @brief Saldatura dei vertici entro una distanza tramite SpatialWeldGrid
+         *
+         * Ogni vertice viene unito al primo vertice già emesso entro tolerance,
+         * quindi nessuna posizione si sposta più della tolleranza. I triangoli
+         * che diventano degeneri (due angoli sullo stesso vertice) vengono scartati.
+         *
+         * @param tolerance Distanza assoluta; se <= 0 è ricavata dal bounding box
+         */
+        static IndexedMesh weldWithTolerance(const Mesh& mesh, float tolerance);
+    };
+
+} // namespace stl2glb
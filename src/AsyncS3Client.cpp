@@ -0,0 +1,891 @@
+#include "stl2glb/AsyncS3Client.hpp"
+#include "stl2glb/EnvironmentHandler.hpp"
+#include "stl2glb/Hasher.hpp"
+#include "stl2glb/Logger.hpp"
+#include "stl2glb/RetryPolicy.hpp"
+#include "stl2glb/SimpleMinioClient.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace stl2glb {
+
+#ifdef __linux__
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        // Buffer di ricezione per loop e di invio per i corpi da file
+        constexpr size_t IO_BUFFER_SIZE = 256 * 1024;
+        // Header di risposta più lunghi indicano un server che non parla HTTP/1.1
+        constexpr size_t MAX_HEADER_SIZE = 64 * 1024;
+        constexpr int MAX_EVENTS = 64;
+        // Intervallo massimo fra due controlli di timeout e connessioni inattive
+        constexpr int TICK_MS = 100;
+
+        std::string toLower(std::string value) {
+            for (auto& c : value) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            return value;
+        }
+
+        std::string trim(const std::string& value) {
+            size_t begin = value.find_first_not_of(" \t");
+            if (begin == std::string::npos) return "";
+            size_t end = value.find_last_not_of(" \t\r");
+            return value.substr(begin, end - begin + 1);
+        }
+
+        RetryableError connectionError(const std::string& what, int error) {
+            return RetryableError(what + ": " + std::strerror(error));
+        }
+    }
+
+/**
+ * @struct AsyncS3Client::Transfer
+ * @brief Stato di una richiesta in un loop: invio di header e corpo, poi parsing della risposta
+ */
+    struct AsyncS3Client::Transfer {
+        AsyncS3Request request;
+        Callback done;
+        std::string head;            // Riga di richiesta e header, firmati
+        int fd = -1;
+        bool reused = false;         // Connessione keep-alive già usata da un'altra richiesta
+        bool connecting = false;
+
+        // Invio
+        size_t headSent = 0;
+        size_t bodySent = 0;
+        int bodyFd = -1;
+        uint64_t fileRead = 0;
+        std::vector<char> sendBuffer;
+        size_t sendPos = 0;
+        size_t sendLength = 0;
+        bool requestSent = false;
+
+        // Ricezione
+        enum class Body { None, Length, Chunked, UntilClose };
+        enum class Chunk { Size, Data, DataEnd, Trailer };
+        bool receivedAny = false;
+        bool headersDone = false;
+        std::string in;
+        Body bodyMode = Body::None;
+        Chunk chunkState = Chunk::Size;
+        uint64_t remaining = 0;
+        int outFd = -1;
+        bool keepAlive = true;
+        bool finished = false;
+        AsyncS3Response response;
+        Clock::time_point deadline;
+
+        ~Transfer() {
+            if (bodyFd != -1) ::close(bodyFd);
+            if (outFd != -1) ::close(outFd);
+        }
+
+        // Riparte da zero su una nuova connessione
+        void resetForRetry() {
+            headSent = bodySent = 0;
+            fileRead = 0;
+            sendPos = sendLength = 0;
+            requestSent = false;
+            reused = false;
+        }
+    };
+
+/**
+ * @class AsyncS3Client::Loop
+ * @brief Event loop epoll su un thread: coda di richieste, connessioni attive e inattive
+ *
+ * post() è l'unico metodo chiamato da altri thread (coda protetta da mutex e
+ * risveglio tramite eventfd); tutto il resto gira sul thread del loop.
+ */
+    class AsyncS3Client::Loop {
+    public:
+        Loop(const sockaddr_storage& address, socklen_t addressLength, const MinioClientSettings& settings,
+             std::atomic<size_t>& inFlight)
+                : address(address), addressLength(addressLength),
+                  maxConnections(std::max(1u, settings.pool_size)),
+                  ioTimeout(std::chrono::seconds(settings.timeout_seconds)),
+                  idleTimeout(std::chrono::seconds(settings.pool_idle_seconds)),
+                  inFlight(inFlight),
+                  recvBuffer(IO_BUFFER_SIZE) {
+            epfd = ::epoll_create1(EPOLL_CLOEXEC);
+            wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (epfd == -1 || wakeFd == -1) {
+                if (epfd != -1) ::close(epfd);
+                if (wakeFd != -1) ::close(wakeFd);
+                throw std::runtime_error("Could not create event loop: " + std::string(std::strerror(errno)));
+            }
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = nullptr;
+            ::epoll_ctl(epfd, EPOLL_CTL_ADD, wakeFd, &event);
+
+            thread = std::thread([this] { run(); });
+        }
+
+        ~Loop() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake();
+            thread.join();
+            ::close(wakeFd);
+            ::close(epfd);
+        }
+
+        Loop(const Loop&) = delete;
+        Loop& operator=(const Loop&) = delete;
+
+        void post(std::unique_ptr<Transfer> transfer) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!stopping) {
+                    queue.push_back(std::move(transfer));
+                    transfer = nullptr;
+                }
+            }
+            if (transfer) {
+                complete(std::move(transfer), std::make_exception_ptr(std::runtime_error("AsyncS3Client stopped")));
+                return;
+            }
+            wake();
+        }
+
+    private:
+        void wake() {
+            uint64_t one = 1;
+            ssize_t written = ::write(wakeFd, &one, sizeof(one));
+            (void)written;
+        }
+
+        void run() {
+            std::vector<epoll_event> events(MAX_EVENTS);
+            while (true) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (stopping) break;
+                    while (!queue.empty()) {
+                        waiting.push_back(std::move(queue.front()));
+                        queue.pop_front();
+                    }
+                }
+                startWaiting();
+
+                int count = ::epoll_wait(epfd, events.data(), MAX_EVENTS, TICK_MS);
+                if (count < 0 && errno != EINTR) {
+                    Logger::error("epoll_wait failed: " + std::string(std::strerror(errno)));
+                    break;
+                }
+                for (int i = 0; i < count; ++i) {
+                    if (events[i].data.ptr == nullptr) {
+                        uint64_t value;
+                        while (::read(wakeFd, &value, sizeof(value)) > 0) {}
+                        continue;
+                    }
+                    auto* transfer = static_cast<Transfer*>(events[i].data.ptr);
+                    if (active.count(transfer)) {
+                        handle(*transfer, events[i].events);
+                    }
+                }
+
+                auto now = Clock::now();
+                expire(now);
+                evictIdle(now);
+            }
+            shutdown();
+        }
+
+        // Avvia le richieste in attesa finché ci sono connessioni disponibili
+        void startWaiting() {
+            while (!waiting.empty()) {
+                Transfer& transfer = *waiting.front();
+                try {
+                    if (!attach(transfer)) return;
+                } catch (...) {
+                    auto failed = std::move(waiting.front());
+                    waiting.pop_front();
+                    complete(std::move(failed), std::current_exception());
+                    continue;
+                }
+                Transfer* key = waiting.front().get();
+                active.emplace(key, std::move(waiting.front()));
+                waiting.pop_front();
+                watch(*key, EPOLLOUT, EPOLL_CTL_ADD);
+            }
+        }
+
+        // Assegna una connessione: inattiva se ce n'è una viva, altrimenti nuova entro il limite
+        bool attach(Transfer& transfer) {
+            while (!idle.empty()) {
+                int fd = idle.back().first;
+                idle.pop_back();
+                char probe;
+                ssize_t n = ::recv(fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+                if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    transfer.fd = fd;
+                    transfer.reused = true;
+                    transfer.deadline = Clock::now() + ioTimeout;
+                    return true;
+                }
+                // Chiusa dal server (o dati inattesi): non riutilizzabile
+                ::close(fd);
+            }
+            if (active.size() >= maxConnections) {
+                return false;
+            }
+            connect(transfer);
+            return true;
+        }
+
+        void connect(Transfer& transfer) {
+            int fd = ::socket(address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (fd == -1) {
+                throw connectionError("Could not create socket", errno);
+            }
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            transfer.connecting = false;
+            if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), addressLength) != 0) {
+                if (errno != EINPROGRESS) {
+                    int error = errno;
+                    ::close(fd);
+                    throw connectionError("Connection failed", error);
+                }
+                transfer.connecting = true;
+            }
+            transfer.fd = fd;
+            transfer.reused = false;
+            transfer.deadline = Clock::now() + ioTimeout;
+        }
+
+        void watch(Transfer& transfer, uint32_t events, int operation) {
+            epoll_event event{};
+            event.events = events;
+            event.data.ptr = &transfer;
+            if (::epoll_ctl(epfd, operation, transfer.fd, &event) != 0) {
+                throw connectionError("epoll_ctl failed", errno);
+            }
+        }
+
+        void handle(Transfer& transfer, uint32_t events) {
+            try {
+                if (transfer.connecting) {
+                    int error = 0;
+                    socklen_t length = sizeof(error);
+                    ::getsockopt(transfer.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+                    if (error != 0) {
+                        throw connectionError("Connection failed", error);
+                    }
+                    transfer.connecting = false;
+                }
+
+                if (!transfer.requestSent) {
+                    if (sendSome(transfer)) {
+                        transfer.requestSent = true;
+                        watch(transfer, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_MOD);
+                    }
+                } else if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                    receiveSome(transfer);
+                }
+
+                if (transfer.finished) {
+                    finish(transfer, nullptr);
+                }
+            } catch (const RetryableError&) {
+                // Connessione keep-alive chiusa dal server prima di rispondere: nuova connessione
+                if (transfer.reused && !transfer.receivedAny && retryOnFreshConnection(transfer)) {
+                    return;
+                }
+                finish(transfer, std::current_exception());
+            } catch (...) {
+                finish(transfer, std::current_exception());
+            }
+        }
+
+        bool retryOnFreshConnection(Transfer& transfer) {
+            ::epoll_ctl(epfd, EPOLL_CTL_DEL, transfer.fd, nullptr);
+            ::close(transfer.fd);
+            transfer.fd = -1;
+            transfer.resetForRetry();
+            try {
+                connect(transfer);
+                watch(transfer, EPOLLOUT, EPOLL_CTL_ADD);
+            } catch (...) {
+                finish(transfer, std::current_exception());
+            }
+            return true;
+        }
+
+        // Invia quanto possibile senza bloccare; true a richiesta completamente inviata
+        bool sendSome(Transfer& transfer) {
+            const AsyncS3Request& request = transfer.request;
+            if (!sendAll(transfer, transfer.head.data(), transfer.head.size(), transfer.headSent)) {
+                return false;
+            }
+            if (!request.body.empty() &&
+                !sendAll(transfer, request.body.data(), request.body.size(), transfer.bodySent)) {
+                return false;
+            }
+            if (transfer.bodyFd == -1) {
+                return true;
+            }
+
+            if (transfer.sendBuffer.empty()) {
+                transfer.sendBuffer.resize(IO_BUFFER_SIZE);
+            }
+            while (true) {
+                if (transfer.sendPos == transfer.sendLength) {
+                    if (transfer.fileRead == request.bodyLength) {
+                        return true;
+                    }
+                    size_t chunk = static_cast<size_t>(
+                            std::min<uint64_t>(transfer.sendBuffer.size(), request.bodyLength - transfer.fileRead));
+                    ssize_t n = ::pread(transfer.bodyFd, transfer.sendBuffer.data(), chunk,
+                                        static_cast<off_t>(request.bodyOffset + transfer.fileRead));
+                    if (n <= 0) {
+                        if (n < 0 && errno == EINTR) continue;
+                        throw std::runtime_error("Could not read " + request.bodyFile + " for upload");
+                    }
+                    transfer.fileRead += static_cast<uint64_t>(n);
+                    transfer.sendPos = 0;
+                    transfer.sendLength = static_cast<size_t>(n);
+                }
+                if (!sendAll(transfer, transfer.sendBuffer.data(), transfer.sendLength, transfer.sendPos)) {
+                    return false;
+                }
+            }
+        }
+
+        // false se il socket non accetta altri dati (EAGAIN)
+        bool sendAll(Transfer& transfer, const char* data, size_t size, size_t& sent) {
+            while (sent < size) {
+                ssize_t n = ::send(transfer.fd, data + sent, size - sent, MSG_NOSIGNAL);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+                    throw connectionError("Send failed", errno);
+                }
+                sent += static_cast<size_t>(n);
+                transfer.deadline = Clock::now() + ioTimeout;
+            }
+            return true;
+        }
+
+        void receiveSome(Transfer& transfer) {
+            while (!transfer.finished) {
+                ssize_t n = ::recv(transfer.fd, recvBuffer.data(), recvBuffer.size(), 0);
+                if (n > 0) {
+                    transfer.receivedAny = true;
+                    transfer.deadline = Clock::now() + ioTimeout;
+                    feed(transfer, recvBuffer.data(), static_cast<size_t>(n));
+                    continue;
+                }
+                if (n == 0) {
+                    if (transfer.headersDone && transfer.bodyMode == Transfer::Body::UntilClose) {
+                        transfer.keepAlive = false;
+                        transfer.finished = true;
+                        return;
+                    }
+                    throw RetryableError("Connection closed by server");
+                }
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+                throw connectionError("Receive failed", errno);
+            }
+        }
+
+        void feed(Transfer& transfer, const char* data, size_t size) {
+            if (transfer.headersDone) {
+                feedBody(transfer, data, size);
+                return;
+            }
+
+            transfer.in.append(data, size);
+            size_t end = transfer.in.find("\r\n\r\n");
+            if (end == std::string::npos) {
+                if (transfer.in.size() > MAX_HEADER_SIZE) {
+                    throw std::runtime_error("Response header too large");
+                }
+                return;
+            }
+
+            std::string rest = transfer.in.substr(end + 4);
+            parseHead(transfer, transfer.in.substr(0, end));
+            transfer.in.clear();
+            transfer.headersDone = true;
+            if (transfer.bodyMode == Transfer::Body::None) {
+                transfer.finished = true;
+                if (!rest.empty()) transfer.keepAlive = false;
+                return;
+            }
+            if (!rest.empty()) {
+                feedBody(transfer, rest.data(), rest.size());
+            }
+        }
+
+        void parseHead(Transfer& transfer, const std::string& head) {
+            AsyncS3Response& response = transfer.response;
+            size_t lineEnd = head.find("\r\n");
+            std::string statusLine = head.substr(0, lineEnd);
+            size_t space = statusLine.find(' ');
+            if (statusLine.compare(0, 5, "HTTP/") != 0 || space == std::string::npos) {
+                throw std::runtime_error("Malformed response status line: " + statusLine);
+            }
+            response.status = std::atoi(statusLine.c_str() + space + 1);
+            if (statusLine.compare(0, 8, "HTTP/1.0") == 0) {
+                transfer.keepAlive = false;
+            }
+
+            size_t position = lineEnd == std::string::npos ? head.size() : lineEnd + 2;
+            while (position < head.size()) {
+                size_t end = head.find("\r\n", position);
+                if (end == std::string::npos) end = head.size();
+                std::string line = head.substr(position, end - position);
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) {
+                    response.headers[toLower(trim(line.substr(0, colon)))] = trim(line.substr(colon + 1));
+                }
+                position = end + 2;
+            }
+
+            auto header = [&](const std::string& name) {
+                auto it = response.headers.find(name);
+                return it == response.headers.end() ? std::string() : toLower(it->second);
+            };
+            if (header("connection") == "close") {
+                transfer.keepAlive = false;
+            }
+
+            // Delimitazione del corpo (RFC 9112, 6.3)
+            int status = response.status;
+            if (transfer.request.method == "HEAD" || status == 204 || status == 304 || status < 200) {
+                transfer.bodyMode = Transfer::Body::None;
+            } else if (header("transfer-encoding").find("chunked") != std::string::npos) {
+                transfer.bodyMode = Transfer::Body::Chunked;
+            } else if (response.headers.count("content-length")) {
+                transfer.remaining = std::strtoull(response.headers["content-length"].c_str(), nullptr, 10);
+                transfer.bodyMode = transfer.remaining > 0 ? Transfer::Body::Length : Transfer::Body::None;
+            } else {
+                transfer.bodyMode = Transfer::Body::UntilClose;
+                transfer.keepAlive = false;
+            }
+
+            // Corpo di una risposta riuscita direttamente nel file di destinazione
+            if (status >= 200 && status < 300 && !transfer.request.responseFile.empty()) {
+                transfer.outFd = ::open(transfer.request.responseFile.c_str(),
+                                        O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+                if (transfer.outFd == -1) {
+                    throw std::runtime_error("Could not open file for writing: " + transfer.request.responseFile);
+                }
+                if (transfer.bodyMode == Transfer::Body::Length) {
+                    posix_fallocate(transfer.outFd, 0, static_cast<off_t>(transfer.remaining));
+                }
+            }
+        }
+
+        void feedBody(Transfer& transfer, const char* data, size_t size) {
+            switch (transfer.bodyMode) {
+                case Transfer::Body::Length: {
+                    size_t take = static_cast<size_t>(std::min<uint64_t>(size, transfer.remaining));
+                    deliver(transfer, data, take);
+                    transfer.remaining -= take;
+                    if (transfer.remaining == 0) {
+                        transfer.finished = true;
+                        // Byte oltre Content-Length: la connessione non è più allineata
+                        if (take < size) transfer.keepAlive = false;
+                    }
+                    break;
+                }
+                case Transfer::Body::UntilClose:
+                    deliver(transfer, data, size);
+                    break;
+                case Transfer::Body::Chunked:
+                    transfer.in.append(data, size);
+                    parseChunks(transfer);
+                    break;
+                case Transfer::Body::None:
+                    break;
+            }
+        }
+
+        void parseChunks(Transfer& transfer) {
+            std::string& in = transfer.in;
+            size_t position = 0;
+            bool progress = true;
+            while (progress && !transfer.finished) {
+                progress = false;
+                switch (transfer.chunkState) {
+                    case Transfer::Chunk::Size: {
+                        size_t end = in.find("\r\n", position);
+                        if (end == std::string::npos) break;
+                        uint64_t size = std::strtoull(in.c_str() + position, nullptr, 16);
+                        position = end + 2;
+                        transfer.remaining = size;
+                        transfer.chunkState = size == 0 ? Transfer::Chunk::Trailer : Transfer::Chunk::Data;
+                        progress = true;
+                        break;
+                    }
+                    case Transfer::Chunk::Data: {
+                        size_t take = static_cast<size_t>(std::min<uint64_t>(in.size() - position, transfer.remaining));
+                        if (take == 0) break;
+                        deliver(transfer, in.data() + position, take);
+                        position += take;
+                        transfer.remaining -= take;
+                        if (transfer.remaining == 0) transfer.chunkState = Transfer::Chunk::DataEnd;
+                        progress = true;
+                        break;
+                    }
+                    case Transfer::Chunk::DataEnd:
+                        if (in.size() - position < 2) break;
+                        position += 2;
+                        transfer.chunkState = Transfer::Chunk::Size;
+                        progress = true;
+                        break;
+                    case Transfer::Chunk::Trailer: {
+                        size_t end = in.find("\r\n", position);
+                        if (end == std::string::npos) break;
+                        if (end == position) transfer.finished = true;
+                        position = end + 2;
+                        progress = true;
+                        break;
+                    }
+                }
+            }
+            in.erase(0, position);
+        }
+
+        void deliver(Transfer& transfer, const char* data, size_t size) {
+            AsyncS3Response& response = transfer.response;
+            if (transfer.outFd == -1) {
+                response.body.append(data, size);
+                response.bodyBytes += size;
+                return;
+            }
+            while (size > 0) {
+                ssize_t n = ::pwrite(transfer.outFd, data, size, static_cast<off_t>(response.bodyBytes));
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    throw std::runtime_error("Write failed on " + transfer.request.responseFile + ": " +
+                                             std::strerror(errno));
+                }
+                data += n;
+                size -= static_cast<size_t>(n);
+                response.bodyBytes += static_cast<uint64_t>(n);
+            }
+        }
+
+        // Toglie la richiesta dal loop, restituisce o chiude la connessione e notifica il chiamante
+        void finish(Transfer& transfer, std::exception_ptr error) {
+            auto it = active.find(&transfer);
+            std::unique_ptr<Transfer> owned = std::move(it->second);
+            active.erase(it);
+
+            if (transfer.fd != -1) {
+                ::epoll_ctl(epfd, EPOLL_CTL_DEL, transfer.fd, nullptr);
+                if (!error && transfer.finished && transfer.keepAlive) {
+                    idle.emplace_back(transfer.fd, Clock::now());
+                } else {
+                    ::close(transfer.fd);
+                }
+                transfer.fd = -1;
+            }
+            if (transfer.outFd != -1) {
+                // Un file incompleto non deve sembrare un download riuscito
+                bool closed = ::close(transfer.outFd) == 0;
+                transfer.outFd = -1;
+                if (!error && !closed) {
+                    error = std::make_exception_ptr(
+                            std::runtime_error("Could not finalize downloaded file: " + transfer.request.responseFile));
+                }
+                if (error) {
+                    std::remove(transfer.request.responseFile.c_str());
+                }
+            }
+            complete(std::move(owned), error);
+        }
+
+        void complete(std::unique_ptr<Transfer> transfer, std::exception_ptr error) {
+            --inFlight;
+            try {
+                transfer->done(error, std::move(transfer->response));
+            } catch (const std::exception& e) {
+                Logger::error("Exception in AsyncS3Client callback: " + std::string(e.what()));
+            } catch (...) {
+                Logger::error("Unknown exception in AsyncS3Client callback");
+            }
+        }
+
+        void expire(Clock::time_point now) {
+            std::vector<Transfer*> expired;
+            for (auto& entry : active) {
+                if (entry.second->deadline <= now) expired.push_back(entry.first);
+            }
+            for (Transfer* transfer : expired) {
+                finish(*transfer, std::make_exception_ptr(RetryableError(
+                        transfer->request.method + " " + transfer->request.path + " timed out")));
+            }
+        }
+
+        // Le connessioni sono in ordine di rilascio: le scadute sono tutte in testa
+        void evictIdle(Clock::time_point now) {
+            size_t expired = 0;
+            while (expired < idle.size() && now - idle[expired].second >= idleTimeout) {
+                ::close(idle[expired].first);
+                ++expired;
+            }
+            idle.erase(idle.begin(), idle.begin() + static_cast<std::ptrdiff_t>(expired));
+        }
+
+        void shutdown() {
+            std::deque<std::unique_ptr<Transfer>> pending;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+                pending.swap(queue);
+            }
+            auto stopped = std::make_exception_ptr(std::runtime_error("AsyncS3Client stopped"));
+            for (auto& transfer : waiting) complete(std::move(transfer), stopped);
+            for (auto& transfer : pending) complete(std::move(transfer), stopped);
+            waiting.clear();
+            while (!active.empty()) {
+                finish(*active.begin()->first, stopped);
+            }
+            for (auto& connection : idle) ::close(connection.first);
+            idle.clear();
+        }
+
+        const sockaddr_storage address;
+        const socklen_t addressLength;
+        const size_t maxConnections;
+        const std::chrono::seconds ioTimeout;
+        const std::chrono::seconds idleTimeout;
+        std::atomic<size_t>& inFlight;
+
+        int epfd = -1;
+        int wakeFd = -1;
+
+        std::mutex mutex;
+        std::deque<std::unique_ptr<Transfer>> queue;
+        bool stopping = false;
+
+        // Solo thread del loop
+        std::deque<std::unique_ptr<Transfer>> waiting;
+        std::unordered_map<Transfer*, std::unique_ptr<Transfer>> active;
+        std::vector<std::pair<int, Clock::time_point>> idle;
+        std::vector<char> recvBuffer;
+
+        std::thread thread;
+    };
+
+    AsyncS3Client::AsyncS3Client(const std::string& endpoint,
+                                 const std::string& accessKey,
+                                 const std::string& secretKey,
+                                 const MinioClientSettings& settings)
+            : settings(settings), signer(accessKey, secretKey) {
+        std::string normalized = SimpleMinioClient::normalizeEndpoint(endpoint);
+        if (normalized.find("https://") == 0) {
+            throw std::runtime_error("AsyncS3Client supports only http:// endpoints");
+        }
+        hostHeader = normalized.substr(normalized.find("://") + 3);
+        std::string host = SimpleMinioClient::endpointHost(normalized);
+        std::string port = std::to_string(SimpleMinioClient::endpointPort(normalized));
+
+        // Risolto una sola volta: i loop si connettono sempre allo stesso indirizzo
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* resolved = nullptr;
+        int rc = ::getaddrinfo(host.c_str(), port.c_str(), &hints, &resolved);
+        if (rc != 0 || !resolved) {
+            throw std::runtime_error("Could not resolve " + host + ": " + ::gai_strerror(rc));
+        }
+        sockaddr_storage address{};
+        std::memcpy(&address, resolved->ai_addr, resolved->ai_addrlen);
+        socklen_t addressLength = resolved->ai_addrlen;
+        ::freeaddrinfo(resolved);
+
+        unsigned int threads = std::max(1u, settings.io_threads);
+        for (unsigned int i = 0; i < threads; ++i) {
+            loops.push_back(std::make_unique<Loop>(address, addressLength, settings, inFlight));
+        }
+        Logger::info("AsyncS3Client: " + std::to_string(threads) + " I/O threads, " +
+                     std::to_string(settings.pool_size) + " connections per thread to " + hostHeader);
+    }
+
+    AsyncS3Client::~AsyncS3Client() = default;
+
+    void AsyncS3Client::submit(AsyncS3Request request, Callback done) {
+        auto transfer = std::make_unique<Transfer>();
+
+        try {
+            uint64_t contentLength = request.body.size();
+            if (!request.bodyFile.empty()) {
+                transfer->bodyFd = ::open(request.bodyFile.c_str(), O_RDONLY | O_CLOEXEC);
+                if (transfer->bodyFd == -1) {
+                    throw std::runtime_error("Could not open file for reading: " + request.bodyFile);
+                }
+                contentLength = request.bodyLength;
+            }
+
+            std::string payloadHash = request.payloadHash;
+            if (payloadHash.empty()) {
+                payloadHash = request.bodyFile.empty() ? Hasher::sha256(request.body.data(), request.body.size())
+                                                       : SimpleMinioClient::UNSIGNED_PAYLOAD;
+            }
+
+            httplib::Headers signedHeaders;
+            signer.sign(signedHeaders, request.method, hostHeader, request.path, request.query, payloadHash);
+
+            std::string& head = transfer->head;
+            head.reserve(512);
+            head.append(request.method).append(" ").append(request.path);
+            if (!request.query.empty()) head.append("?").append(request.query);
+            head.append(" HTTP/1.1\r\n");
+            for (const auto& header : signedHeaders) {
+                head.append(header.first).append(": ").append(header.second).append("\r\n");
+            }
+            for (const auto& header : request.headers) {
+                head.append(header.first).append(": ").append(header.second).append("\r\n");
+            }
+            head.append("User-Agent: SimpleMinioClient/1.0\r\n");
+            if (contentLength > 0 || request.method == "PUT" || request.method == "POST") {
+                head.append("Content-Length: ").append(std::to_string(contentLength)).append("\r\n");
+            }
+            head.append("\r\n");
+        } catch (...) {
+            done(std::current_exception(), AsyncS3Response{});
+            return;
+        }
+
+        transfer->request = std::move(request);
+        transfer->done = std::move(done);
+        ++inFlight;
+        loops[nextLoop++ % loops.size()]->post(std::move(transfer));
+    }
+
+#else
+
+    class AsyncS3Client::Loop {};
+    struct AsyncS3Client::Transfer {};
+
+    AsyncS3Client::AsyncS3Client(const std::string&, const std::string& accessKey,
+                                 const std::string& secretKey, const MinioClientSettings& settings)
+            : settings(settings), signer(accessKey, secretKey) {
+        throw std::runtime_error("AsyncS3Client requires Linux (epoll)");
+    }
+
+    AsyncS3Client::~AsyncS3Client() = default;
+
+    void AsyncS3Client::submit(AsyncS3Request, Callback done) {
+        done(std::make_exception_ptr(std::runtime_error("AsyncS3Client requires Linux (epoll)")), AsyncS3Response{});
+    }
+
+#endif
+
+    AsyncS3Client& AsyncS3Client::instance() {
+        auto& env = EnvironmentHandler::instance();
+        static AsyncS3Client client(env.getMinioEndpoint(), env.getMinioAccessKey(),
+                                    env.getMinioSecretKey(), env.getMinioClientSettings());
+        return client;
+    }
+
+    std::future<AsyncS3Response> AsyncS3Client::submit(AsyncS3Request request) {
+        auto promise = std::make_shared<std::promise<AsyncS3Response>>();
+        auto future = promise->get_future();
+        submit(std::move(request), [promise](std::exception_ptr error, AsyncS3Response&& response) {
+            if (error) {
+                promise->set_exception(error);
+            } else {
+                promise->set_value(std::move(response));
+            }
+        });
+        return future;
+    }
+
+    std::future<AsyncS3Response> AsyncS3Client::submitChecked(AsyncS3Request request, bool allowNotFound) {
+        auto promise = std::make_shared<std::promise<AsyncS3Response>>();
+        auto future = promise->get_future();
+        std::string operation = request.method + " " + request.path;
+        submit(std::move(request), [promise, operation, allowNotFound](std::exception_ptr error,
+                                                                       AsyncS3Response&& response) {
+            if (!error && (response.status < 200 || response.status >= 300) &&
+                !(allowNotFound && response.status == 404)) {
+                Logger::error(operation + " failed, response: " + response.body);
+                try {
+                    RetryPolicy::throwForStatus(operation + " failed with status", response.status);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            if (error) {
+                promise->set_exception(error);
+            } else {
+                promise->set_value(std::move(response));
+            }
+        });
+        return future;
+    }
+
+    std::future<AsyncS3Response> AsyncS3Client::get(const std::string& bucket,
+                                                    const std::string& objectName,
+                                                    const std::string& localPath) {
+        AsyncS3Request request;
+        request.method = "GET";
+        request.path = "/" + bucket + "/" + objectName;
+        request.responseFile = localPath;
+        return submitChecked(std::move(request), false);
+    }
+
+    std::future<AsyncS3Response> AsyncS3Client::put(const std::string& bucket,
+                                                    const std::string& objectName,
+                                                    const std::string& localPath,
+                                                    const std::string& payloadSha256) {
+        AsyncS3Request request;
+        request.method = "PUT";
+        request.path = "/" + bucket + "/" + objectName;
+        request.headers.emplace_back("Content-Type", "model/gltf-binary");
+        request.bodyFile = localPath;
+        request.payloadHash = payloadSha256;
+        std::error_code error;
+        request.bodyLength = std::filesystem::file_size(localPath, error);
+        if (error) {
+            std::promise<AsyncS3Response> failed;
+            failed.set_exception(std::make_exception_ptr(
+                    std::runtime_error("File not found for upload: " + localPath)));
+            return failed.get_future();
+        }
+        return submitChecked(std::move(request), false);
+    }
+
+    std::future<AsyncS3Response> AsyncS3Client::head(const std::string& bucket, const std::string& objectName) {
+        AsyncS3Request request;
+        request.method = "HEAD";
+        request.path = "/" + bucket + "/" + objectName;
+        return submitChecked(std::move(request), true);
+    }
+
+} // namespace stl2glb
@@ -0,0 +1,217 @@
+#include "stl2glb/AwsV4Signer.hpp"
+#include "stl2glb/Hasher.hpp"
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+namespace stl2glb {
+
+    namespace {
+        constexpr const char* ALGORITHM = "AWS4-HMAC-SHA256";
+        constexpr const char* SIGNED_HEADERS = "host;x-amz-content-sha256;x-amz-date";
+
+        // Algoritmi risolti una sola volta per processo (il fetch implicito ha un costo per chiamata)
+        EVP_MAC* hmacAlgorithm() {
+            static EVP_MAC* mac = [] {
+                EVP_MAC* fetched = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
+                if (!fetched) throw std::runtime_error("Failed to fetch HMAC");
+                return fetched;
+            }();
+            return mac;
+        }
+
+        EVP_MD* sha256Algorithm() {
+            static EVP_MD* md = [] {
+                EVP_MD* fetched = EVP_MD_fetch(nullptr, "SHA256", nullptr);
+                if (!fetched) throw std::runtime_error("Failed to fetch SHA256");
+                return fetched;
+            }();
+            return md;
+        }
+
+        // Contesti e buffer riutilizzati dal thread corrente
+        struct ThreadState {
+            EVP_MAC_CTX* mac = nullptr;
+            EVP_MD_CTX* md = nullptr;
+            std::string canonicalRequest;
+            std::string stringToSign;
+
+            ThreadState() {
+                mac = EVP_MAC_CTX_new(hmacAlgorithm());
+                md = EVP_MD_CTX_new();
+                if (!mac || !md) {
+                    EVP_MAC_CTX_free(mac);
+                    EVP_MD_CTX_free(md);
+                    throw std::runtime_error("Failed to create signing contexts");
+                }
+                canonicalRequest.reserve(512);
+                stringToSign.reserve(256);
+            }
+
+            ~ThreadState() {
+                EVP_MAC_CTX_free(mac);
+                EVP_MD_CTX_free(md);
+            }
+
+            ThreadState(const ThreadState&) = delete;
+            ThreadState& operator=(const ThreadState&) = delete;
+
+            // Chiave con cui è inizializzato mac: se è la stessa, EVP_MAC_init senza
+            // chiave né parametri riparte dallo stato già calcolato
+            AwsV4Signer::Key keyedWith{};
+            bool keyed = false;
+
+            void hmac(const unsigned char* key, size_t keyLength, const std::string& data, unsigned char* out) {
+                bool sameKey = keyed && keyLength == keyedWith.size() &&
+                               std::memcmp(key, keyedWith.data(), keyLength) == 0;
+
+                int initialized;
+                if (sameKey) {
+                    initialized = EVP_MAC_init(mac, nullptr, 0, nullptr);
+                } else {
+                    OSSL_PARAM params[] = {
+                            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA256"), 0),
+                            OSSL_PARAM_construct_end()
+                    };
+                    initialized = EVP_MAC_init(mac, key, keyLength, params);
+                    keyed = keyLength == keyedWith.size();
+                    if (keyed) std::memcpy(keyedWith.data(), key, keyLength);
+                }
+
+                size_t outLength = 0;
+                if (initialized != 1 ||
+                    EVP_MAC_update(mac, reinterpret_cast<const unsigned char*>(data.data()), data.size()) != 1 ||
+                    EVP_MAC_final(mac, out, &outLength, 32) != 1 || outLength != 32) {
+                    keyed = false;
+                    throw std::runtime_error("Failed to compute HMAC");
+                }
+            }
+
+            std::string sha256Hex(const std::string& data) {
+                unsigned char digest[32];
+                unsigned int length = 0;
+                if (EVP_DigestInit_ex(md, sha256Algorithm(), nullptr) != 1 ||
+                    EVP_DigestUpdate(md, data.data(), data.size()) != 1 ||
+                    EVP_DigestFinal_ex(md, digest, &length) != 1) {
+                    throw std::runtime_error("Failed to hash canonical request");
+                }
+                return Hasher::toHex(digest, length);
+            }
+        };
+
+        ThreadState& threadState() {
+            thread_local ThreadState state;
+            return state;
+        }
+
+        // "YYYYMMDDTHHMMSSZ" in UTC; gmtime_r perché gmtime non è thread-safe
+        std::string formatAmzDate(std::chrono::system_clock::time_point now) {
+            std::time_t time = std::chrono::system_clock::to_time_t(now);
+            std::tm tm{};
+#ifdef _WIN32
+            gmtime_s(&tm, &time);
+#else
+            gmtime_r(&time, &tm);
+#endif
+            char buffer[17];
+            std::strftime(buffer, sizeof(buffer), "%Y%m%dT%H%M%SZ", &tm);
+            return std::string(buffer, 16);
+        }
+    }
+
+    AwsV4Signer::AwsV4Signer(std::string accessKey, std::string secretKey, std::string region, std::string service)
+            : accessKey(std::move(accessKey)), secretKey(std::move(secretKey)),
+              region(std::move(region)), service(std::move(service)) {}
+
+    void AwsV4Signer::sign(httplib::Headers& headers,
+                           const std::string& method,
+                           const std::string& host,
+                           const std::string& canonicalUri,
+                           const std::string& payloadHash,
+                           std::chrono::system_clock::time_point now) const {
+        sign(headers, method, host, canonicalUri, "", payloadHash, now);
+    }
+
+    void AwsV4Signer::sign(httplib::Headers& headers,
+                           const std::string& method,
+                           const std::string& host,
+                           const std::string& canonicalUri,
+                           const std::string& canonicalQuery,
+                           const std::string& payloadHash,
+                           std::chrono::system_clock::time_point now) const {
+        ThreadState& state = threadState();
+
+        std::string amzDate = formatAmzDate(now);
+        std::string dateStamp = amzDate.substr(0, 8);
+        std::string credentialScope = dateStamp + "/" + region + "/" + service + "/aws4_request";
+
+        // Canonical request
+        std::string& canonical = state.canonicalRequest;
+        canonical.clear();
+        canonical.append(method).append("\n")
+                .append(canonicalUri).append("\n")
+                .append(canonicalQuery).append("\n")
+                .append("host:").append(host).append("\n")
+                .append("x-amz-content-sha256:").append(payloadHash).append("\n")
+                .append("x-amz-date:").append(amzDate).append("\n")
+                .append("\n")
+                .append(SIGNED_HEADERS).append("\n")
+                .append(payloadHash);
+
+        std::string& stringToSign = state.stringToSign;
+        stringToSign.clear();
+        stringToSign.append(ALGORITHM).append("\n")
+                .append(amzDate).append("\n")
+                .append(credentialScope).append("\n")
+                .append(state.sha256Hex(canonical));
+
+        Key key = signingKey(dateStamp);
+        unsigned char signature[32];
+        state.hmac(key.data(), key.size(), stringToSign, signature);
+
+        headers.emplace("Host", host);
+        headers.emplace("x-amz-date", amzDate);
+        headers.emplace("x-amz-content-sha256", payloadHash);
+        headers.emplace("Authorization", std::string(ALGORITHM) + " Credential=" + accessKey + "/" + credentialScope +
+                                         ", SignedHeaders=" + SIGNED_HEADERS +
+                                         ", Signature=" + Hasher::toHex(signature, sizeof(signature)));
+    }
+
+    AwsV4Signer::Key AwsV4Signer::signingKey(const std::string& dateStamp) const {
+        {
+            std::lock_guard<std::mutex> lock(keyMutex);
+            if (dateStamp == cachedDate) {
+                return cachedKey;
+            }
+        }
+
+        // Derivata fuori dal lock: al cambio di data più thread possono calcolarla, con lo stesso risultato
+        Key key = deriveSigningKey(dateStamp);
+
+        std::lock_guard<std::mutex> lock(keyMutex);
+        if (cachedDate.empty() || dateStamp > cachedDate) {
+            cachedDate = dateStamp;
+            cachedKey = key;
+        }
+        return key;
+    }
+
+    AwsV4Signer::Key AwsV4Signer::deriveSigningKey(const std::string& dateStamp) const {
+        ThreadState& state = threadState();
+
+        std::string secret = "AWS4" + secretKey;
+        Key kDate, kRegion, kService, kSigning;
+        state.hmac(reinterpret_cast<const unsigned char*>(secret.data()), secret.size(), dateStamp, kDate.data());
+        state.hmac(kDate.data(), kDate.size(), region, kRegion.data());
+        state.hmac(kRegion.data(), kRegion.size(), service, kService.data());
+        state.hmac(kService.data(), kService.size(), "aws4_request", kSigning.data());
+
+        OPENSSL_cleanse(secret.data(), secret.size());
+        return kSigning;
+    }
+
+} // namespace stl2glb
@@ -0,0 +1,173 @@
+#include "stl2glb/Blake3.hpp"
+#include "stl2glb/Parallel.hpp"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace stl2glb {
+
+    namespace {
+        constexpr size_t BLOCK_LEN = 64;
+        constexpr size_t CHUNK_LEN = 1024;
+
+        // Sottoalberi più piccoli di così vengono calcolati sul thread corrente
+        constexpr size_t MIN_PARALLEL_BYTES = 1024 * 1024;
+
+        constexpr uint32_t CHUNK_START = 1u << 0;
+        constexpr uint32_t CHUNK_END = 1u << 1;
+        constexpr uint32_t PARENT = 1u << 2;
+        constexpr uint32_t ROOT = 1u << 3;
+
+        constexpr uint32_t IV[8] = {
+                0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+        };
+
+        constexpr uint8_t MSG_SCHEDULE[7][16] = {
+                {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+                {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+                {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+                {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+                {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+                {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+                {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+        };
+
+        inline uint32_t rotr(uint32_t x, int n) {
+            return (x >> n) | (x << (32 - n));
+        }
+
+        inline uint32_t load32(const uint8_t* p) {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        inline void g(uint32_t* s, int a, int b, int c, int d, uint32_t mx, uint32_t my) {
+            s[a] = s[a] + s[b] + mx;
+            s[d] = rotr(s[d] ^ s[a], 16);
+            s[c] = s[c] + s[d];
+            s[b] = rotr(s[b] ^ s[c], 12);
+            s[a] = s[a] + s[b] + my;
+            s[d] = rotr(s[d] ^ s[a], 8);
+            s[c] = s[c] + s[d];
+            s[b] = rotr(s[b] ^ s[c], 7);
+        }
+
+        // Funzione di compressione: aggiorna cv con un blocco da 64 byte
+        void compress(uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint32_t blockLen,
+                      uint64_t counter, uint32_t flags) {
+            uint32_t m[16];
+            for (int i = 0; i < 16; ++i) {
+                m[i] = load32(block + i * 4);
+            }
+
+            uint32_t s[16] = {
+                    cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+                    IV[0], IV[1], IV[2], IV[3],
+                    static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), blockLen, flags
+            };
+
+            for (const auto& schedule : MSG_SCHEDULE) {
+                g(s, 0, 4, 8, 12, m[schedule[0]], m[schedule[1]]);
+                g(s, 1, 5, 9, 13, m[schedule[2]], m[schedule[3]]);
+                g(s, 2, 6, 10, 14, m[schedule[4]], m[schedule[5]]);
+                g(s, 3, 7, 11, 15, m[schedule[6]], m[schedule[7]]);
+                g(s, 0, 5, 10, 15, m[schedule[8]], m[schedule[9]]);
+                g(s, 1, 6, 11, 12, m[schedule[10]], m[schedule[11]]);
+                g(s, 2, 7, 8, 13, m[schedule[12]], m[schedule[13]]);
+                g(s, 3, 4, 9, 14, m[schedule[14]], m[schedule[15]]);
+            }
+
+            for (int i = 0; i < 8; ++i) {
+                cv[i] = s[i] ^ s[i + 8];
+            }
+        }
+
+        // Chaining value di un chunk (al massimo CHUNK_LEN byte)
+        void chunkCv(const uint8_t* input, size_t len, uint64_t chunkCounter, uint32_t rootFlag, uint32_t cv[8]) {
+            std::memcpy(cv, IV, sizeof(IV));
+
+            size_t numBlocks = std::max<size_t>(1, (len + BLOCK_LEN - 1) / BLOCK_LEN);
+            for (size_t b = 0; b < numBlocks; ++b) {
+                size_t offset = b * BLOCK_LEN;
+                size_t blockLen = std::min(BLOCK_LEN, len - offset);
+
+                uint8_t block[BLOCK_LEN] = {};
+                std::memcpy(block, input + offset, blockLen);
+
+                uint32_t flags = 0;
+                if (b == 0) flags |= CHUNK_START;
+                if (b == numBlocks - 1) flags |= CHUNK_END | rootFlag;
+                compress(cv, block, static_cast<uint32_t>(blockLen), chunkCounter, flags);
+            }
+        }
+
+        // Il sottoalbero sinistro contiene la massima potenza di due di chunk
+        // strettamente inferiore al totale
+        size_t leftLen(size_t len) {
+            size_t fullChunks = (len - 1) / CHUNK_LEN;
+            size_t power = 1;
+            while (power * 2 <= fullChunks) {
+                power *= 2;
+            }
+            return power * CHUNK_LEN;
+        }
+
+        void subtreeCv(const uint8_t* input, size_t len, uint64_t chunkCounter, uint32_t rootFlag,
+                       unsigned threads, uint32_t cv[8]) {
+            if (len <= CHUNK_LEN) {
+                chunkCv(input, len, chunkCounter, rootFlag, cv);
+                return;
+            }
+
+            size_t left = leftLen(len);
+            uint32_t children[16];
+
+            // I due figli sono indipendenti: con core liberi il sinistro va su un altro thread
+            if (threads > 1 && len >= MIN_PARALLEL_BYTES) {
+                unsigned leftThreads = threads / 2;
+                Parallel::run(2, [&](size_t t) {
+                    if (t == 0) {
+                        subtreeCv(input, left, chunkCounter, 0, leftThreads, children);
+                    } else {
+                        subtreeCv(input + left, len - left, chunkCounter + left / CHUNK_LEN, 0,
+                                  threads - leftThreads, children + 8);
+                    }
+                });
+            } else {
+                subtreeCv(input, left, chunkCounter, 0, 1, children);
+                subtreeCv(input + left, len - left, chunkCounter + left / CHUNK_LEN, 0, 1, children + 8);
+            }
+
+            // Nodo padre: il blocco è la concatenazione dei due chaining value
+            uint8_t block[BLOCK_LEN];
+            for (int i = 0; i < 16; ++i) {
+                block[i * 4] = static_cast<uint8_t>(children[i]);
+                block[i * 4 + 1] = static_cast<uint8_t>(children[i] >> 8);
+                block[i * 4 + 2] = static_cast<uint8_t>(children[i] >> 16);
+                block[i * 4 + 3] = static_cast<uint8_t>(children[i] >> 24);
+            }
+            std::memcpy(cv, IV, sizeof(IV));
+            compress(cv, block, BLOCK_LEN, 0, PARENT | rootFlag);
+        }
+    }
+
+    Blake3::Digest Blake3::hash(const void* data, size_t size, unsigned numThreads) {
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        uint32_t cv[8];
+        subtreeCv(static_cast<const uint8_t*>(data), size, 0, ROOT, numThreads, cv);
+
+        Digest digest;
+        for (int i = 0; i < 8; ++i) {
+            digest[i * 4] = static_cast<uint8_t>(cv[i]);
+            digest[i * 4 + 1] = static_cast<uint8_t>(cv[i] >> 8);
+            digest[i * 4 + 2] = static_cast<uint8_t>(cv[i] >> 16);
+            digest[i * 4 + 3] = static_cast<uint8_t>(cv[i] >> 24);
+        }
+        return digest;
+    }
+
+} // namespace stl2glb
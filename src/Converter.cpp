@@ -1,32 +1,66 @@
 #include "stl2glb/Converter.hpp"
-#include "stl2glb/MinioClient.hpp"
 #include "stl2glb/STLParser.hpp"
 #include "stl2glb/GLBWriter.hpp"
 #include "stl2glb/Hasher.hpp"
 #include "stl2glb/Logger.hpp"
 #include "stl2glb/EnvironmentHandler.hpp"
+#include "stl2glb/StorageBackend.hpp"
 
 #include <filesystem>
 #include <chrono>
+#include <charconv>
+#include <atomic>
+#include <unistd.h>
 
 namespace fs = std::filesystem;
 
 namespace stl2glb {
 
-    std::string Converter::run(const std::string& stl_hash) {
+    namespace {
+        // PID + contatore: unico tra i thread del processo e tra processi sulla stessa /tmp
+        std::string uniqueRunId() {
+            static std::atomic<uint64_t> counter{0};
+            return std::to_string(getpid()) + "-" + std::to_string(counter.fetch_add(1));
+        }
+    }
+
+    std::string Converter::cacheKey(const std::string& stl_hash, const ConversionOptions& options) {
+        auto& env = EnvironmentHandler::instance();
+
+        // fusedParse non compare: i due percorsi producono lo stesso GLB
+        std::string descriptor = std::string(VERSION) + "|" + stl_hash +
+                                 "|weld=" + ConversionOptions::weldModeName(options.weldMode);
+        if (options.weldMode == WeldMode::Tolerance) {
+            char text[32];
+            auto result = std::to_chars(text, text + sizeof(text), options.weldTolerance);
+            descriptor += "|tolerance=" + std::string(text, result.ptr);
+        }
+        descriptor += env.useTinyGltfWriter() ? "|writer=tinygltf" : "|writer=direct";
+        descriptor += env.useBlake3ContentHash() ? "|hash=blake3" : "|hash=sha256";
+
+        return Hasher::sha256(descriptor.data(), descriptor.size());
+    }
+
+    std::string Converter::run(const std::string& stl_hash, const ConversionOptions& options) {
         auto& env = EnvironmentHandler::instance();
+        auto& storage = StorageBackend::instance();
         auto start_time = std::chrono::high_resolution_clock::now();
 
-        Logger::info("Start conversion for STL hash: " + stl_hash);
+        Logger::info("Start conversion for STL hash: " + stl_hash +
+                     " (weld: " + ConversionOptions::weldModeName(options.weldMode) + ")");
 
-        std::string stl_path = "/tmp/" + stl_hash + ".stl";
-        std::string glb_path = "/tmp/" + stl_hash + ".glb";
+        // Percorsi temporanei unici per esecuzione: conversioni concorrenti dello
+        // stesso STL (o con lo stesso GLB risultante) non condividono file
+        std::string run_id = uniqueRunId();
+        std::string stl_path = "/tmp/" + stl_hash + "." + run_id + ".stl";
+        std::string glb_path = "/tmp/" + stl_hash + "." + run_id + ".glb";
+        std::string final_glb;
 
         try {
             // Download STL
             auto download_start = std::chrono::high_resolution_clock::now();
             Logger::info("Start downloading STL file with hash: " + stl_hash);
-            MinioClient::download(env.getStlBucketName(), stl_hash, stl_path);
+            storage.get(env.getStlBucketName(), stl_hash, stl_path);
             auto download_end = std::chrono::high_resolution_clock::now();
             auto download_ms = std::chrono::duration_cast<std::chrono::milliseconds>(download_end - download_start).count();
             Logger::info("STL file downloaded in " + std::to_string(download_ms) + "ms");
@@ -35,18 +69,25 @@ namespace stl2glb {
             auto file_size = fs::file_size(stl_path);
             Logger::info("STL file size: " + std::to_string(file_size / 1024) + " KB");
 
-            // Parse STL
+            // Parse STL e saldatura dei vertici
             auto parse_start = std::chrono::high_resolution_clock::now();
             Logger::info("STL Parsing...");
-            auto triangles = STLParser::parse(stl_path);
+            auto mesh = STLParser::parseWelded(stl_path, options);
             auto parse_end = std::chrono::high_resolution_clock::now();
             auto parse_ms = std::chrono::duration_cast<std::chrono::milliseconds>(parse_end - parse_start).count();
-            Logger::info("STL Parsed " + std::to_string(triangles.size()) + " triangles in " + std::to_string(parse_ms) + "ms");
+            Logger::info("STL Parsed " + std::to_string(mesh.triangleCount()) + " triangles (" +
+                         std::to_string(mesh.vertexCount()) + " unique vertices) in " + std::to_string(parse_ms) + "ms");
 
             // Write GLB
             auto write_start = std::chrono::high_resolution_clock::now();
             Logger::info("GLB writing...");
-            GLBWriter::write(triangles, glb_path);
+            // Il writer diretto calcola l'hash mentre scrive il file
+            std::string glb_hash;
+            if (env.useTinyGltfWriter()) {
+                GLBWriter::writeWithTinyGltf(mesh, glb_path);
+            } else {
+                glb_hash = GLBWriter::write(mesh, glb_path);
+            }
             auto write_end = std::chrono::high_resolution_clock::now();
             auto write_ms = std::chrono::duration_cast<std::chrono::milliseconds>(write_end - write_start).count();
             Logger::info("GLB written in " + std::to_string(write_ms) + "ms");
@@ -56,21 +97,36 @@ namespace stl2glb {
             Logger::info("GLB file size: " + std::to_string(glb_size / 1024) + " KB");
             Logger::info("Compression ratio: " + std::to_string((float)glb_size / file_size * 100) + "%");
 
-            // Calculate hash
-            Logger::info("Calculating hash of converted file");
-            std::string glb_hash = Hasher::sha256_file(glb_path);
+            // SHA-256 del payload: dal writer diretto; se assente il corpo viene inviato non firmato
+            std::string payload_sha256 = glb_hash;
+
+            // Calculate hash. Con STL2GLB_CONTENT_HASH=blake3 la chiave è "blake3-<hex>",
+            // calcolata in parallelo, e convive con gli oggetti nominati con SHA-256
+            if (env.useBlake3ContentHash()) {
+                Logger::info("Calculating BLAKE3 hash of converted file");
+                glb_hash = "blake3-" + Hasher::blake3_file(glb_path);
+            } else if (glb_hash.empty()) {
+                Logger::info("Calculating hash of converted file");
+                glb_hash = Hasher::sha256_file(glb_path);
+                payload_sha256 = glb_hash;
+            }
             Logger::info("Hash: " + glb_hash);
 
             // Rename and upload
-            std::string final_glb = "/tmp/" + glb_hash + ".glb";
+            final_glb = "/tmp/" + glb_hash + "." + run_id + ".glb";
             fs::rename(glb_path, final_glb);
 
             auto upload_start = std::chrono::high_resolution_clock::now();
-            Logger::info("Uploading converted file to bucket...");
-            MinioClient::upload(env.getGlbBucketName(), glb_hash, final_glb);
-            auto upload_end = std::chrono::high_resolution_clock::now();
-            auto upload_ms = std::chrono::duration_cast<std::chrono::milliseconds>(upload_end - upload_start).count();
-            Logger::info("File uploaded in " + std::to_string(upload_ms) + "ms");
+            // Il nome è l'hash del contenuto: se l'oggetto esiste i byte sono già quelli
+            if (storage.head(env.getGlbBucketName(), glb_hash)) {
+                Logger::info("GLB already present in bucket, upload skipped");
+            } else {
+                Logger::info("Uploading converted file to bucket...");
+                storage.put(env.getGlbBucketName(), glb_hash, final_glb, payload_sha256);
+                auto upload_end = std::chrono::high_resolution_clock::now();
+                auto upload_ms = std::chrono::duration_cast<std::chrono::milliseconds>(upload_end - upload_start).count();
+                Logger::info("File uploaded in " + std::to_string(upload_ms) + "ms");
+            }
 
             // Cleanup temporary files
             try {
@@ -93,6 +149,7 @@ namespace stl2glb {
             try {
                 if (fs::exists(stl_path)) fs::remove(stl_path);
                 if (fs::exists(glb_path)) fs::remove(glb_path);
+                if (!final_glb.empty() && fs::exists(final_glb)) fs::remove(final_glb);
             } catch (...) {}
 
             throw;
@@ -1,9 +1,25 @@
 #include "stl2glb/EnvironmentHandler.hpp"
+#include <cerrno>
 #include <cstdlib>
+#include <limits>
 #include <stdexcept>
 
 namespace stl2glb {
 
+    namespace {
+        // Intero senza segno in base 10; qualsiasi altro contenuto è un errore di configurazione
+        size_t parseUnsigned(const char* name, const char* value) {
+            char* end = nullptr;
+            errno = 0;
+            unsigned long long parsed = std::strtoull(value, &end, 10);
+            if (end == value || *end != '\0' || errno != 0 || value[0] == '-' ||
+                parsed > std::numeric_limits<unsigned int>::max()) {
+                throw std::runtime_error("Invalid " + std::string(name) + ": " + value);
+            }
+            return static_cast<size_t>(parsed);
+        }
+    }
+
     EnvironmentHandler& EnvironmentHandler::instance() {
         static EnvironmentHandler instance;
         return instance;
@@ -16,15 +32,150 @@ namespace stl2glb {
         const char* accessKey = std::getenv("STL2GLB_MINIO_ACCESS_KEY");
         const char* secretKey = std::getenv("STL2GLB_MINIO_SECRET_KEY");
 
-        if (!stl_bucket || !glb_bucket || !endpoint || !accessKey || !secretKey) {
+        if (const char* storage = std::getenv("STL2GLB_STORAGE")) {
+            storageType = StorageBackend::typeFromString(storage);
+        }
+
+        if (const char* root = std::getenv("STL2GLB_STORAGE_ROOT")) {
+            storageRoot = root;
+            if (storageRoot.empty()) {
+                throw std::runtime_error("Invalid STL2GLB_STORAGE_ROOT: must not be empty");
+            }
+        }
+
+        // Le credenziali MinIO servono solo al backend S3
+        bool needsMinio = storageType == StorageType::S3;
+        if (!stl_bucket || !glb_bucket || (needsMinio && (!endpoint || !accessKey || !secretKey))) {
             throw std::runtime_error("Missing one or more required environment variables.");
         }
 
         stlBucketName = stl_bucket;
         glbBucketName = glb_bucket;
-        minioEndpoint = endpoint;
-        minioAccessKey = accessKey;
-        minioSecretKey = secretKey;
+        minioEndpoint = endpoint ? endpoint : "";
+        minioAccessKey = accessKey ? accessKey : "";
+        minioSecretKey = secretKey ? secretKey : "";
+
+        // Variabili opzionali
+        const char* glbWriter = std::getenv("STL2GLB_GLB_WRITER");
+        if (glbWriter) {
+            std::string writer = glbWriter;
+            if (writer != "direct" && writer != "tinygltf") {
+                throw std::runtime_error("Invalid STL2GLB_GLB_WRITER: " + writer);
+            }
+            tinyGltfWriter = writer == "tinygltf";
+        }
+
+        const char* contentHash = std::getenv("STL2GLB_CONTENT_HASH");
+        if (contentHash) {
+            std::string algorithm = contentHash;
+            if (algorithm != "sha256" && algorithm != "blake3") {
+                throw std::runtime_error("Invalid STL2GLB_CONTENT_HASH: " + algorithm);
+            }
+            blake3ContentHash = algorithm == "blake3";
+        }
+
+        if (const char* cacheSize = std::getenv("STL2GLB_RESULT_CACHE_SIZE")) {
+            resultCacheSize = parseUnsigned("STL2GLB_RESULT_CACHE_SIZE", cacheSize);
+        }
+
+        const char* cacheIndex = std::getenv("STL2GLB_RESULT_CACHE_INDEX");
+        if (cacheIndex) {
+            resultCacheIndexPath = cacheIndex;
+        }
+
+        const char* cacheMirror = std::getenv("STL2GLB_RESULT_CACHE_MIRROR");
+        if (cacheMirror) {
+            std::string mirror = cacheMirror;
+            if (mirror != "true" && mirror != "false") {
+                throw std::runtime_error("Invalid STL2GLB_RESULT_CACHE_MIRROR: " + mirror);
+            }
+            resultCacheMirror = mirror == "true";
+        }
+
+        if (const char* poolSize = std::getenv("STL2GLB_MINIO_POOL_SIZE")) {
+            minioClientSettings.pool_size = static_cast<unsigned int>(parseUnsigned("STL2GLB_MINIO_POOL_SIZE", poolSize));
+            if (minioClientSettings.pool_size == 0) {
+                throw std::runtime_error("Invalid STL2GLB_MINIO_POOL_SIZE: must be at least 1");
+            }
+        }
+
+        if (const char* poolIdle = std::getenv("STL2GLB_MINIO_POOL_IDLE_SECONDS")) {
+            minioClientSettings.pool_idle_seconds =
+                    static_cast<unsigned int>(parseUnsigned("STL2GLB_MINIO_POOL_IDLE_SECONDS", poolIdle));
+        }
+
+        if (const char* retries = std::getenv("STL2GLB_MINIO_RETRY_COUNT")) {
+            minioClientSettings.retry_count =
+                    static_cast<unsigned int>(parseUnsigned("STL2GLB_MINIO_RETRY_COUNT", retries));
+        }
+
+        if (const char* timeout = std::getenv("STL2GLB_MINIO_TIMEOUT_SECONDS")) {
+            minioClientSettings.timeout_seconds =
+                    static_cast<unsigned int>(parseUnsigned("STL2GLB_MINIO_TIMEOUT_SECONDS", timeout));
+            if (minioClientSettings.timeout_seconds == 0) {
+                throw std::runtime_error("Invalid STL2GLB_MINIO_TIMEOUT_SECONDS: must be at least 1");
+            }
+        }
+
+        if (const char* percentile = std::getenv("STL2GLB_MINIO_HEDGE_PERCENTILE")) {
+            minioClientSettings.hedge_percentile =
+                    static_cast<unsigned int>(parseUnsigned("STL2GLB_MINIO_HEDGE_PERCENTILE", percentile));
+            if (minioClientSettings.hedge_percentile >= 100) {
+                throw std::runtime_error("Invalid STL2GLB_MINIO_HEDGE_PERCENTILE: must be below 100");
+            }
+        }
+
+        if (const char* io = std::getenv("STL2GLB_MINIO_IO")) {
+            std::string mode = io;
+            if (mode != "sync" && mode != "async") {
+                throw std::runtime_error("Invalid STL2GLB_MINIO_IO: " + mode);
+            }
+            minioClientSettings.async_io = mode == "async";
+        }
+
+        if (const char* ioThreads = std::getenv("STL2GLB_MINIO_IO_THREADS")) {
+            minioClientSettings.io_threads =
+                    static_cast<unsigned int>(parseUnsigned("STL2GLB_MINIO_IO_THREADS", ioThreads));
+            if (minioClientSettings.io_threads == 0) {
+                throw std::runtime_error("Invalid STL2GLB_MINIO_IO_THREADS: must be at least 1");
+            }
+        }
+
+        if (const char* partSize = std::getenv("STL2GLB_DOWNLOAD_PART_MB")) {
+            minioClientSettings.download_part_bytes =
+                    static_cast<uint64_t>(parseUnsigned("STL2GLB_DOWNLOAD_PART_MB", partSize)) * 1024 * 1024;
+            if (minioClientSettings.download_part_bytes == 0) {
+                throw std::runtime_error("Invalid STL2GLB_DOWNLOAD_PART_MB: must be at least 1");
+            }
+        }
+
+        if (const char* concurrency = std::getenv("STL2GLB_DOWNLOAD_CONCURRENCY")) {
+            minioClientSettings.download_concurrency =
+                    static_cast<unsigned int>(parseUnsigned("STL2GLB_DOWNLOAD_CONCURRENCY", concurrency));
+        }
+
+        if (const char* minSize = std::getenv("STL2GLB_PARALLEL_DOWNLOAD_MIN_MB")) {
+            minioClientSettings.parallel_download_min_bytes =
+                    static_cast<uint64_t>(parseUnsigned("STL2GLB_PARALLEL_DOWNLOAD_MIN_MB", minSize)) * 1024 * 1024;
+        }
+
+        if (const char* partSize = std::getenv("STL2GLB_MULTIPART_PART_MB")) {
+            minioClientSettings.multipart_part_bytes =
+                    static_cast<uint64_t>(parseUnsigned("STL2GLB_MULTIPART_PART_MB", partSize)) * 1024 * 1024;
+            if (minioClientSettings.multipart_part_bytes < 5ull * 1024 * 1024) {
+                throw std::runtime_error("Invalid STL2GLB_MULTIPART_PART_MB: must be at least 5");
+            }
+        }
+
+        if (const char* concurrency = std::getenv("STL2GLB_UPLOAD_CONCURRENCY")) {
+            minioClientSettings.upload_concurrency =
+                    static_cast<unsigned int>(parseUnsigned("STL2GLB_UPLOAD_CONCURRENCY", concurrency));
+        }
+
+        if (const char* minSize = std::getenv("STL2GLB_MULTIPART_MIN_MB")) {
+            minioClientSettings.multipart_min_bytes =
+                    static_cast<uint64_t>(parseUnsigned("STL2GLB_MULTIPART_MIN_MB", minSize)) * 1024 * 1024;
+        }
     }
 
     const std::string& EnvironmentHandler::getStlBucketName() const {
@@ -35,6 +186,14 @@ namespace stl2glb {
         return glbBucketName;
     }
 
+    StorageType EnvironmentHandler::getStorageType() const {
+        return storageType;
+    }
+
+    const std::string& EnvironmentHandler::getStorageRoot() const {
+        return storageRoot;
+    }
+
     const std::string& EnvironmentHandler::getMinioEndpoint() const {
         return minioEndpoint;
     }
@@ -47,4 +206,28 @@ namespace stl2glb {
         return minioSecretKey;
     }
 
+    bool EnvironmentHandler::useTinyGltfWriter() const {
+        return tinyGltfWriter;
+    }
+
+    bool EnvironmentHandler::useBlake3ContentHash() const {
+        return blake3ContentHash;
+    }
+
+    size_t EnvironmentHandler::getResultCacheSize() const {
+        return resultCacheSize;
+    }
+
+    const std::string& EnvironmentHandler::getResultCacheIndexPath() const {
+        return resultCacheIndexPath;
+    }
+
+    bool EnvironmentHandler::mirrorResultCache() const {
+        return resultCacheMirror;
+    }
+
+    const MinioClientSettings& EnvironmentHandler::getMinioClientSettings() const {
+        return minioClientSettings;
+    }
+
 } // namespace stl2glb
@@ -0,0 +1,209 @@
+#include "stl2glb/FileSystemStorageBackend.hpp"
+#include "stl2glb/Logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unistd.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace stl2glb {
+
+    namespace {
+        // Componente di percorso accettata nei nomi di bucket e oggetti
+        bool validComponent(const std::string& component) {
+            return !component.empty() && component != "." && component != ".." &&
+                   component.find('\0') == std::string::npos && component.find('\\') == std::string::npos;
+        }
+
+        void removeQuietly(const fs::path& path) {
+            std::error_code ec;
+            fs::remove(path, ec);
+        }
+    }
+
+    FileSystemStorageBackend::FileSystemStorageBackend(const std::string& root) : root(root) {
+        if (root.empty()) {
+            throw std::runtime_error("Filesystem storage requires a root directory");
+        }
+        fs::create_directories(this->root);
+        Logger::info("Filesystem storage rooted at " + this->root.string());
+    }
+
+    fs::path FileSystemStorageBackend::objectPath(const std::string& bucket, const std::string& objectName) const {
+        if (!validComponent(bucket) || bucket.find('/') != std::string::npos) {
+            throw std::runtime_error("Invalid bucket name: " + bucket);
+        }
+
+        fs::path path = root / bucket;
+        size_t start = 0;
+        do {
+            size_t end = objectName.find('/', start);
+            std::string component = objectName.substr(start, end == std::string::npos ? end : end - start);
+            if (!validComponent(component)) {
+                throw std::runtime_error("Invalid object name: " + objectName);
+            }
+            path /= component;
+            start = end == std::string::npos ? end : end + 1;
+        } while (start != std::string::npos);
+
+        return path;
+    }
+
+    fs::path FileSystemStorageBackend::stagingPath(const fs::path& target) {
+        static std::atomic<uint64_t> counter{0};
+
+        fs::create_directories(target.parent_path());
+        // Nome nascosto: non collide con oggetti ordinari e non è visibile a head/get
+        std::string name = "." + target.filename().string() + ".tmp-" +
+                           std::to_string(getpid()) + "-" + std::to_string(counter.fetch_add(1));
+        return target.parent_path() / name;
+    }
+
+    void FileSystemStorageBackend::get(const std::string& bucket,
+                                       const std::string& objectName,
+                                       const std::string& localPath) {
+        fs::path source = objectPath(bucket, objectName);
+        if (!fs::is_regular_file(source)) {
+            throw std::runtime_error("Object not found: " + bucket + "/" + objectName);
+        }
+
+        fs::path destination(localPath);
+        if (destination.has_parent_path()) {
+            fs::create_directories(destination.parent_path());
+        }
+        // copy_file usa copy_file_range/sendfile dove disponibili: nessun buffer in user space
+        fs::copy_file(source, destination, fs::copy_options::overwrite_existing);
+    }
+
+    void FileSystemStorageBackend::getRange(const std::string& bucket,
+                                            const std::string& objectName,
+                                            uint64_t offset,
+                                            uint64_t length,
+                                            std::string& content) {
+        content.clear();
+        fs::path path = objectPath(bucket, objectName);
+        std::error_code ec;
+        uint64_t size = fs::file_size(path, ec);
+        if (ec) {
+            throw std::runtime_error("Object not found: " + bucket + "/" + objectName);
+        }
+        if (length == 0) {
+            return;
+        }
+        if (offset >= size) {
+            throw std::runtime_error("Range start " + std::to_string(offset) + " beyond end of " +
+                                     bucket + "/" + objectName);
+        }
+
+        content.resize(static_cast<size_t>(std::min(length, size - offset)));
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            throw std::runtime_error("Could not open " + path.string() + ": " + std::strerror(errno));
+        }
+        size_t done = 0;
+        while (done < content.size()) {
+            ssize_t n = ::pread(fd, &content[done], content.size() - done, static_cast<off_t>(offset + done));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                int error = errno;
+                ::close(fd);
+                throw std::runtime_error("Could not read " + path.string() + ": " +
+                                         (n == 0 ? std::string("unexpected end of file") : std::strerror(error)));
+            }
+            done += static_cast<size_t>(n);
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(static_cast<std::streamoff>(offset));
+        if (!in.read(&content[0], static_cast<std::streamsize>(content.size()))) {
+            throw std::runtime_error("Could not read " + path.string());
+        }
+#endif
+    }
+
+    void FileSystemStorageBackend::put(const std::string& bucket,
+                                       const std::string& objectName,
+                                       const std::string& localPath,
+                                       const std::string&) {
+        if (!fs::is_regular_file(localPath)) {
+            throw std::runtime_error("File not found for upload: " + localPath);
+        }
+
+        fs::path target = objectPath(bucket, objectName);
+        fs::path staging = stagingPath(target);
+        try {
+            fs::copy_file(localPath, staging, fs::copy_options::overwrite_existing);
+            fs::rename(staging, target);
+        } catch (...) {
+            removeQuietly(staging);
+            throw;
+        }
+    }
+
+    bool FileSystemStorageBackend::head(const std::string& bucket, const std::string& objectName, uint64_t* size) {
+        try {
+            fs::path path = objectPath(bucket, objectName);
+            std::error_code ec;
+            if (!fs::is_regular_file(path, ec)) {
+                return false;
+            }
+            if (size) {
+                *size = fs::file_size(path, ec);
+                if (ec) return false;
+            }
+            return true;
+        } catch (const std::exception& e) {
+            Logger::warn("Exception in head: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    bool FileSystemStorageBackend::getText(const std::string& bucket,
+                                           const std::string& objectName,
+                                           std::string& content) {
+        fs::path path = objectPath(bucket, objectName);
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            if (!fs::exists(path)) {
+                return false;
+            }
+            throw std::runtime_error("Could not open " + path.string());
+        }
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (in.bad()) {
+            throw std::runtime_error("Could not read " + path.string());
+        }
+        return true;
+    }
+
+    void FileSystemStorageBackend::putText(const std::string& bucket,
+                                           const std::string& objectName,
+                                           const std::string& content) {
+        fs::path target = objectPath(bucket, objectName);
+        fs::path staging = stagingPath(target);
+        try {
+            std::ofstream out(staging, std::ios::binary | std::ios::trunc);
+            out.write(content.data(), static_cast<std::streamsize>(content.size()));
+            out.close();
+            if (!out) {
+                throw std::runtime_error("Could not write " + staging.string());
+            }
+            fs::rename(staging, target);
+        } catch (...) {
+            removeQuietly(staging);
+            throw;
+        }
+    }
+
+} // namespace stl2glb
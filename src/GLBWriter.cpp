@@ -1,22 +1,145 @@
 // GLBWriter.cpp semplificato e corretto
 #include "stl2glb/GLBWriter.hpp"
 #include "stl2glb/Logger.hpp"
+#include "stl2glb/VertexWelder.hpp"
+#include "stl2glb/HashingFileWriter.hpp"
 #include <tiny_gltf.h>
 #include <stdexcept>
-#include <unordered_map>
 #include <array>
+#include <charconv>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <algorithm>
 
 namespace stl2glb {
 
-    void GLBWriter::write(const std::vector<Triangle>& triangles, const std::string& outputPath) {
-        if (triangles.empty()) {
+    namespace {
+        constexpr uint32_t GLB_MAGIC = 0x46546C67;      // "glTF"
+        constexpr uint32_t GLB_VERSION = 2;
+        constexpr uint32_t CHUNK_TYPE_JSON = 0x4E4F534A; // "JSON"
+        constexpr uint32_t CHUNK_TYPE_BIN = 0x004E4942;  // "BIN\0"
+
+        // Valore esatto del float come double (come tinygltf), così min/max coincidono
+        // con i dati anche per i validatori che leggono il JSON in doppia precisione;
+        // to_chars è indipendente dal locale
+        void appendFloat(std::string& out, float value) {
+            char text[32];
+            auto result = std::to_chars(text, text + sizeof(text), static_cast<double>(value));
+            out.append(text, result.ptr);
+        }
+
+        void appendVec3(std::string& out, const std::array<float, 3>& v) {
+            out += '[';
+            for (int k = 0; k < 3; ++k) {
+                if (k > 0) out += ',';
+                appendFloat(out, v[k]);
+            }
+            out += ']';
+        }
+
+        // Chunk JSON compatto: stessa scena, materiale e accessor del percorso tinygltf
+        std::string buildJson(const IndexedMesh& welded, size_t positionBytes, size_t normalBytes,
+                              size_t indexBytes) {
+            const bool hasNormals = normalBytes > 0;
+            const std::string indexView = hasNormals ? "2" : "1";
+
+            std::string json;
+            json.reserve(1024);
+            json += R"({"asset":{"version":"2.0","generator":"STL2GLB Converter"},)";
+            json += R"("scene":0,"scenes":[{"nodes":[0]}],"nodes":[{"mesh":0}],)";
+            json += R"("meshes":[{"primitives":[{"attributes":{"POSITION":0)";
+            if (hasNormals) json += R"(,"NORMAL":1)";
+            json += R"(},"indices":)" + indexView + R"(,"material":0,"mode":4}]}],)";
+            json += R"("materials":[{"name":"STL_Material","pbrMetallicRoughness":)";
+            json += R"({"baseColorFactor":[0.8,0.8,0.8,1],"metallicFactor":0.1,"roughnessFactor":0.5},)";
+            json += R"("doubleSided":true}],)";
+
+            json += R"("accessors":[{"bufferView":0,"componentType":5126,"count":)" +
+                    std::to_string(welded.vertexCount()) + R"(,"type":"VEC3","min":)";
+            appendVec3(json, welded.minBounds);
+            json += R"(,"max":)";
+            appendVec3(json, welded.maxBounds);
+            json += '}';
+            if (hasNormals) {
+                json += R"(,{"bufferView":1,"componentType":5126,"count":)" +
+                        std::to_string(welded.normals.size() / 3) + R"(,"type":"VEC3"})";
+            }
+            json += R"(,{"bufferView":)" + indexView + R"(,"componentType":5125,"count":)" +
+                    std::to_string(welded.indices.size()) + R"(,"type":"SCALAR"}],)";
+
+            json += R"("bufferViews":[{"buffer":0,"byteOffset":0,"byteLength":)" +
+                    std::to_string(positionBytes) + R"(,"target":34962})";
+            if (hasNormals) {
+                json += R"(,{"buffer":0,"byteOffset":)" + std::to_string(positionBytes) +
+                        R"(,"byteLength":)" + std::to_string(normalBytes) + R"(,"target":34962})";
+            }
+            json += R"(,{"buffer":0,"byteOffset":)" + std::to_string(positionBytes + normalBytes) +
+                    R"(,"byteLength":)" + std::to_string(indexBytes) + R"(,"target":34963}],)";
+
+            json += R"("buffers":[{"byteLength":)" + std::to_string(positionBytes + normalBytes + indexBytes) + "}]}";
+            return json;
+        }
+    }
+
+    std::string GLBWriter::write(const Mesh& input, const std::string& outputPath, const ConversionOptions& options) {
+        if (input.empty()) {
+            throw std::runtime_error("No triangles to write");
+        }
+
+        // Saldatura dei vertici coincidenti (esatta o entro tolleranza)
+        return write(VertexWelder::weld(input, options), outputPath);
+    }
+
+    std::string GLBWriter::write(const IndexedMesh& welded, const std::string& outputPath) {
+        if (welded.triangleCount() == 0) {
             throw std::runtime_error("No triangles to write");
         }
 
-        Logger::info("Writing GLB with " + std::to_string(triangles.size()) + " triangles");
+        Logger::info("Writing GLB with " + std::to_string(welded.triangleCount()) + " triangles");
+        Logger::info("Unique vertices: " + std::to_string(welded.vertexCount()));
+
+        // Layout del chunk BIN: posizioni, normali, indici (tutti multipli di 4 byte)
+        const size_t positionBytes = welded.vertices.byteSize();
+        const size_t normalBytes = welded.normals.byteSize();
+        const size_t indexBytes = welded.indices.byteSize();
+        const size_t binLength = positionBytes + normalBytes + indexBytes;
+
+        // Il chunk JSON va allineato a 4 byte con spazi
+        std::string json = buildJson(welded, positionBytes, normalBytes, indexBytes);
+        json.append((4 - json.size() % 4) % 4, ' ');
+
+        const size_t totalLength = 12 + 8 + json.size() + 8 + binLength;
+        if (totalLength > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("GLB output exceeds 4 GB: " + std::to_string(totalLength) + " bytes");
+        }
+
+        // Header GLB + header del chunk JSON, poi header del chunk BIN (little endian)
+        uint32_t header[5] = {GLB_MAGIC, GLB_VERSION, static_cast<uint32_t>(totalLength),
+                              static_cast<uint32_t>(json.size()), CHUNK_TYPE_JSON};
+        uint32_t binHeader[2] = {static_cast<uint32_t>(binLength), CHUNK_TYPE_BIN};
+
+        HashingFileWriter writer(outputPath);
+        writer.write({
+                {header, sizeof(header)},
+                {json.data(), json.size()},
+                {binHeader, sizeof(binHeader)},
+                {welded.vertices.data(), positionBytes},
+                {welded.normals.data(), normalBytes},
+                {welded.indices.data(), indexBytes},
+        });
+        std::string sha256 = writer.finish();
+
+        Logger::info("Successfully wrote GLB file: " + outputPath);
+        return sha256;
+    }
+
+    void GLBWriter::writeWithTinyGltf(const IndexedMesh& welded, const std::string& outputPath) {
+        if (welded.triangleCount() == 0) {
+            throw std::runtime_error("No triangles to write");
+        }
+
+        Logger::info("Writing GLB with " + std::to_string(welded.triangleCount()) + " triangles (tinygltf)");
 
         // Prepara il modello glTF
         tinygltf::Model model;
@@ -39,70 +162,13 @@ namespace stl2glb {
         material.doubleSided = true; // Importante per STL
         model.materials.push_back(material);
 
-        // Prepara i dati dei vertici
-        std::vector<float> vertices;
-        std::vector<float> normals;
-        std::vector<uint32_t> indices;
-
-        // Mappa per deduplicare i vertici
-        std::map<std::array<float, 3>, uint32_t> uniqueVertices;
-
-        // Bounds per il calcolo del bounding box
-        std::array<float, 3> minBounds = {
-                std::numeric_limits<float>::max(),
-                std::numeric_limits<float>::max(),
-                std::numeric_limits<float>::max()
-        };
-        std::array<float, 3> maxBounds = {
-                std::numeric_limits<float>::lowest(),
-                std::numeric_limits<float>::lowest(),
-                std::numeric_limits<float>::lowest()
-        };
-
-        // Processa i triangoli
-        for (const auto& tri : triangles) {
-            // Array di vertici del triangolo
-            std::array<std::array<float, 3>, 3> triVerts = {{
-                                                                    {tri.vertex1[0], tri.vertex1[1], tri.vertex1[2]},
-                                                                    {tri.vertex2[0], tri.vertex2[1], tri.vertex2[2]},
-                                                                    {tri.vertex3[0], tri.vertex3[1], tri.vertex3[2]}
-                                                            }};
-
-            // Processa ogni vertice
-            for (const auto& vert : triVerts) {
-                uint32_t index;
-
-                // Controlla se il vertice esiste già
-                auto it = uniqueVertices.find(vert);
-                if (it != uniqueVertices.end()) {
-                    index = it->second;
-                } else {
-                    // Nuovo vertice
-                    index = static_cast<uint32_t>(vertices.size() / 3);
-                    uniqueVertices[vert] = index;
-
-                    // Aggiungi vertice
-                    vertices.push_back(vert[0]);
-                    vertices.push_back(vert[1]);
-                    vertices.push_back(vert[2]);
-
-                    // Aggiungi normale (usa la normale del triangolo)
-                    normals.push_back(tri.normal[0]);
-                    normals.push_back(tri.normal[1]);
-                    normals.push_back(tri.normal[2]);
-
-                    // Aggiorna bounds
-                    for (int i = 0; i < 3; ++i) {
-                        minBounds[i] = std::min(minBounds[i], vert[i]);
-                        maxBounds[i] = std::max(maxBounds[i], vert[i]);
-                    }
-                }
-
-                indices.push_back(index);
-            }
-        }
+        const auto& vertices = welded.vertices;
+        const auto& normals = welded.normals;
+        const auto& indices = welded.indices;
+        const auto& minBounds = welded.minBounds;
+        const auto& maxBounds = welded.maxBounds;
 
-        Logger::info("Unique vertices: " + std::to_string(vertices.size() / 3));
+        Logger::info("Unique vertices: " + std::to_string(welded.vertexCount()));
 
         // Calcola gli offset e le dimensioni
         size_t vertexByteLength = vertices.size() * sizeof(float);
@@ -138,13 +204,17 @@ namespace stl2glb {
         vertexBufferView.target = TINYGLTF_TARGET_ARRAY_BUFFER;
         model.bufferViews.push_back(vertexBufferView);
 
-        int normalBufferViewIndex = model.bufferViews.size();
-        tinygltf::BufferView normalBufferView;
-        normalBufferView.buffer = 0;
-        normalBufferView.byteOffset = normalOffset;
-        normalBufferView.byteLength = normalByteLength;
-        normalBufferView.target = TINYGLTF_TARGET_ARRAY_BUFFER;
-        model.bufferViews.push_back(normalBufferView);
+        // Le normali sono assenti se la Mesh non le porta
+        int normalBufferViewIndex = -1;
+        if (!normals.empty()) {
+            normalBufferViewIndex = model.bufferViews.size();
+            tinygltf::BufferView normalBufferView;
+            normalBufferView.buffer = 0;
+            normalBufferView.byteOffset = normalOffset;
+            normalBufferView.byteLength = normalByteLength;
+            normalBufferView.target = TINYGLTF_TARGET_ARRAY_BUFFER;
+            model.bufferViews.push_back(normalBufferView);
+        }
 
         int indexBufferViewIndex = model.bufferViews.size();
         tinygltf::BufferView indexBufferView;
@@ -166,14 +236,17 @@ namespace stl2glb {
         positionAccessor.maxValues = {maxBounds[0], maxBounds[1], maxBounds[2]};
         model.accessors.push_back(positionAccessor);
 
-        int normalAccessorIndex = model.accessors.size();
-        tinygltf::Accessor normalAccessor;
-        normalAccessor.bufferView = normalBufferViewIndex;
-        normalAccessor.byteOffset = 0;
-        normalAccessor.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
-        normalAccessor.count = normals.size() / 3;
-        normalAccessor.type = TINYGLTF_TYPE_VEC3;
-        model.accessors.push_back(normalAccessor);
+        int normalAccessorIndex = -1;
+        if (normalBufferViewIndex >= 0) {
+            normalAccessorIndex = model.accessors.size();
+            tinygltf::Accessor normalAccessor;
+            normalAccessor.bufferView = normalBufferViewIndex;
+            normalAccessor.byteOffset = 0;
+            normalAccessor.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
+            normalAccessor.count = normals.size() / 3;
+            normalAccessor.type = TINYGLTF_TYPE_VEC3;
+            model.accessors.push_back(normalAccessor);
+        }
 
         int indexAccessorIndex = model.accessors.size();
         tinygltf::Accessor indexAccessor;
@@ -186,7 +259,9 @@ namespace stl2glb {
 
         // Configura la primitive
         primitive.attributes["POSITION"] = positionAccessorIndex;
-        primitive.attributes["NORMAL"] = normalAccessorIndex;
+        if (normalAccessorIndex >= 0) {
+            primitive.attributes["NORMAL"] = normalAccessorIndex;
+        }
         primitive.indices = indexAccessorIndex;
         primitive.material = 0;
         primitive.mode = TINYGLTF_MODE_TRIANGLES;
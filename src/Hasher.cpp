@@ -1,58 +1,199 @@
 #include "stl2glb/Hasher.hpp"
+#include "stl2glb/Blake3.hpp"
+#include "stl2glb/Mesh.hpp"
 #include <openssl/evp.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
-#include <sstream>
-#include <iomanip>
+#include <iterator>
 #include <stdexcept>
-#include <memory>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace stl2glb {
 
+    namespace {
+#ifndef _WIN32
+        // Hash tramite mapping del file: nessuna copia dal page cache. Le pagine già
+        // elaborate vengono rilasciate, quindi la memoria residente resta limitata
+        // anche su file da diversi GB. Restituisce false se il file non è mappabile.
+        bool hashMapped(int fd, size_t size, Sha256& hash) {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) return false;
+
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            const unsigned char* data = static_cast<const unsigned char*>(mapping);
+            for (size_t offset = 0; offset < size; offset += Hasher::BLOCK_SIZE) {
+                size_t chunk = std::min(Hasher::BLOCK_SIZE, size - offset);
+                hash.update(data + offset, chunk);
+                madvise(const_cast<unsigned char*>(data) + offset, chunk, MADV_DONTNEED);
+            }
+
+            munmap(mapping, size);
+            return true;
+        }
+
+        // Lettura a blocchi interi in un buffer allineato (file non mappabili, es. pipe)
+        void hashRead(int fd, const std::string& path, Sha256& hash) {
+            AlignedBuffer<unsigned char> buffer(Hasher::BLOCK_SIZE);
+
+            while (true) {
+                size_t filled = 0;
+                while (filled < Hasher::BLOCK_SIZE) {
+                    ssize_t n = ::read(fd, buffer.data() + filled, Hasher::BLOCK_SIZE - filled);
+                    if (n < 0) {
+                        if (errno == EINTR) continue;
+                        throw std::runtime_error("Failed to read file for hashing: " + path +
+                                                 " (" + std::strerror(errno) + ")");
+                    }
+                    if (n == 0) break;
+                    filled += static_cast<size_t>(n);
+                }
+
+                if (filled > 0) {
+                    hash.update(buffer.data(), filled);
+                }
+                if (filled < Hasher::BLOCK_SIZE) break;
+            }
+        }
+#endif
+    }
+
     std::string Hasher::sha256_file(const std::string& path) {
+        Sha256 hash;
+
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Unable to open file for hashing: " + path);
+        }
+
+        AlignedBuffer<char> buffer(BLOCK_SIZE);
+        while (file.read(buffer.data(), BLOCK_SIZE) || file.gcount() > 0) {
+            hash.update(buffer.data(), static_cast<size_t>(file.gcount()));
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("Unable to open file for hashing: " + path);
+        }
+
+        try {
+            // Readahead aggressivo del kernel per la lettura sequenziale
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+            struct stat sb;
+            bool mapped = fstat(fd, &sb) == 0 && S_ISREG(sb.st_mode) && sb.st_size > 0 &&
+                          hashMapped(fd, static_cast<size_t>(sb.st_size), hash);
+            if (!mapped) {
+                hashRead(fd, path, hash);
+            }
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+#endif
+
+        return hash.hexDigest();
+    }
+
+    std::string Hasher::sha256(const void* data, size_t size) {
+        Sha256 hash;
+        hash.update(data, size);
+        return hash.hexDigest();
+    }
+
+    std::string Hasher::blake3_file(const std::string& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("Unable to open file for hashing: " + path);
+        }
+
+        // L'albero viene visitato in parallelo, quindi serve l'intero file mappato
+        struct stat sb;
+        if (fstat(fd, &sb) == 0 && S_ISREG(sb.st_mode) && sb.st_size > 0) {
+            size_t size = static_cast<size_t>(sb.st_size);
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                ::close(fd);
+                madvise(mapping, size, MADV_WILLNEED);
+                std::string hex;
+                try {
+                    hex = blake3(mapping, size);
+                } catch (...) {
+                    munmap(mapping, size);
+                    throw;
+                }
+                munmap(mapping, size);
+                return hex;
+            }
+        }
+        ::close(fd);
+#endif
+
+        // File non mappabili (o Windows): lettura completa in memoria
         std::ifstream file(path, std::ios::binary);
         if (!file) {
             throw std::runtime_error("Unable to open file for hashing: " + path);
         }
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return blake3(content.data(), content.size());
+    }
+
+    std::string Hasher::blake3(const void* data, size_t size) {
+        auto digest = Blake3::hash(data, size);
+        return toHex(digest.data(), digest.size());
+    }
+
+    std::string Hasher::toHex(const unsigned char* digest, size_t length) {
+        static constexpr char digits[] = "0123456789abcdef";
+
+        std::string hex(length * 2, '0');
+        for (size_t i = 0; i < length; ++i) {
+            hex[i * 2] = digits[digest[i] >> 4];
+            hex[i * 2 + 1] = digits[digest[i] & 0x0F];
+        }
+        return hex;
+    }
 
-        // Usa la moderna API EVP di OpenSSL 3.0+
-        EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+    // Usa la moderna API EVP di OpenSSL 3.0+
+    Sha256::Sha256() : ctx(EVP_MD_CTX_new()) {
         if (!ctx) {
             throw std::runtime_error("Failed to create hash context");
         }
 
-        // Unique pointer per cleanup automatico
-        std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctxPtr(ctx, EVP_MD_CTX_free);
-
         if (EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr) != 1) {
+            EVP_MD_CTX_free(ctx);
             throw std::runtime_error("Failed to initialize SHA256 hash");
         }
+    }
 
-        char buffer[4096];
-        while (file.read(buffer, sizeof(buffer))) {
-            if (EVP_DigestUpdate(ctx, buffer, file.gcount()) != 1) {
-                throw std::runtime_error("Failed to update hash");
-            }
-        }
+    Sha256::~Sha256() {
+        EVP_MD_CTX_free(ctx);
+    }
 
-        // Last partial read
-        if (file.gcount() > 0) {
-            if (EVP_DigestUpdate(ctx, buffer, file.gcount()) != 1) {
-                throw std::runtime_error("Failed to update hash");
-            }
+    void Sha256::update(const void* data, size_t size) {
+        if (EVP_DigestUpdate(ctx, data, size) != 1) {
+            throw std::runtime_error("Failed to update hash");
         }
+    }
 
+    std::string Sha256::hexDigest() {
         unsigned char hash[EVP_MAX_MD_SIZE];
         unsigned int hashLen;
         if (EVP_DigestFinal_ex(ctx, hash, &hashLen) != 1) {
             throw std::runtime_error("Failed to finalize hash");
         }
 
-        std::ostringstream oss;
-        for (unsigned int i = 0; i < hashLen; ++i) {
-            oss << std::hex << std::setw(2) << std::setfill('0') << (int)hash[i];
-        }
-
-        return oss.str();
+        return Hasher::toHex(hash, hashLen);
     }
 
 } // namespace stl2glb
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "stl2glb/HashingFileWriter.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace stl2glb {
+
+#ifdef _WIN32
+    HashingFileWriter::HashingFileWriter(const std::string& path)
+            : path(path), file(path, std::ios::binary | std::ios::trunc) {
+        if (!file) {
+            throw std::runtime_error("Failed to open file for writing: " + path);
+        }
+    }
+
+    HashingFileWriter::~HashingFileWriter() = default;
+
+    void HashingFileWriter::write(std::initializer_list<Segment> segments) {
+        for (const auto& segment : segments) {
+            hash.update(segment.data, segment.size);
+            file.write(static_cast<const char*>(segment.data), static_cast<std::streamsize>(segment.size));
+            written += segment.size;
+        }
+        if (!file) {
+            throw std::runtime_error("Failed to write file: " + path);
+        }
+    }
+
+    std::string HashingFileWriter::finish() {
+        file.close();
+        if (!file) {
+            throw std::runtime_error("Failed to close file: " + path);
+        }
+        return hash.hexDigest();
+    }
+#else
+    HashingFileWriter::HashingFileWriter(const std::string& path)
+            : path(path), fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) {
+        if (fd == -1) {
+            throw std::runtime_error("Failed to open file for writing: " + path +
+                                     " (" + std::strerror(errno) + ")");
+        }
+    }
+
+    HashingFileWriter::~HashingFileWriter() {
+        if (fd != -1) ::close(fd);
+    }
+
+    void HashingFileWriter::write(std::initializer_list<Segment> segments) {
+        std::vector<iovec> iov;
+        iov.reserve(segments.size());
+        for (const auto& segment : segments) {
+            if (segment.size == 0) continue;
+            hash.update(segment.data, segment.size);
+            iov.push_back(iovec{const_cast<void*>(segment.data), segment.size});
+            written += segment.size;
+        }
+
+        // writev può scrivere meno del richiesto (limite di ~2 GB per chiamata)
+        size_t first = 0;
+        while (first < iov.size()) {
+            ssize_t n = ::writev(fd, iov.data() + first, static_cast<int>(iov.size() - first));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Failed to write file: " + path + " (" + std::strerror(errno) + ")");
+            }
+
+            size_t remaining = static_cast<size_t>(n);
+            while (first < iov.size() && remaining >= iov[first].iov_len) {
+                remaining -= iov[first].iov_len;
+                ++first;
+            }
+            if (remaining > 0) {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + remaining;
+                iov[first].iov_len -= remaining;
+            }
+        }
+    }
+
+    std::string HashingFileWriter::finish() {
+        int result = ::close(fd);
+        fd = -1;
+        if (result != 0) {
+            throw std::runtime_error("Failed to close file: " + path + " (" + std::strerror(errno) + ")");
+        }
+        return hash.hexDigest();
+    }
+#endif
+
+} // namespace stl2glb
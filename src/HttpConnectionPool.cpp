@@ -0,0 +1,104 @@
+#include "stl2glb/HttpConnectionPool.hpp"
+#include <httplib.h>
+#include <algorithm>
+
+namespace stl2glb {
+
+    HttpConnectionPool::Lease::Lease(HttpConnectionPool* pool, std::unique_ptr<httplib::Client> client)
+            : pool(pool), client(std::move(client)) {}
+
+    HttpConnectionPool::Lease::Lease(Lease&& other) noexcept
+            : pool(other.pool), client(std::move(other.client)), reusable(other.reusable) {
+        other.pool = nullptr;
+    }
+
+    HttpConnectionPool::Lease::~Lease() {
+        if (pool && client) {
+            pool->release(std::move(client), reusable);
+        }
+    }
+
+    HttpConnectionPool::HttpConnectionPool(std::string host, int port, size_t maxSize,
+                                           std::chrono::seconds idleTimeout, std::chrono::seconds ioTimeout)
+            : host(std::move(host)), port(port), maxSize(std::max<size_t>(1, maxSize)),
+              idleTimeout(idleTimeout), ioTimeout(ioTimeout) {}
+
+    HttpConnectionPool::~HttpConnectionPool() = default;
+
+    HttpConnectionPool::Lease HttpConnectionPool::acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        evictExpired(Clock::now());
+
+        if (idle.empty() && leased >= maxSize) {
+            ++counters.waits;
+            available.wait(lock, [this] { return !idle.empty() || leased < maxSize; });
+        }
+
+        if (!idle.empty()) {
+            std::unique_ptr<httplib::Client> client = std::move(idle.back().client);
+            idle.pop_back();
+            ++leased;
+            ++counters.reused;
+            return Lease(this, std::move(client));
+        }
+
+        // La connessione TCP viene aperta alla prima richiesta, fuori dal lock
+        ++leased;
+        ++counters.created;
+        lock.unlock();
+
+        try {
+            return Lease(this, createClient());
+        } catch (...) {
+            lock.lock();
+            --leased;
+            available.notify_one();
+            throw;
+        }
+    }
+
+    HttpPoolStats HttpConnectionPool::stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        HttpPoolStats snapshot = counters;
+        snapshot.idle = idle.size();
+        snapshot.leased = leased;
+        return snapshot;
+    }
+
+    std::unique_ptr<httplib::Client> HttpConnectionPool::createClient() const {
+        auto client = std::make_unique<httplib::Client>(host, port);
+        client->set_keep_alive(true);
+        client->set_connection_timeout(ioTimeout.count());
+        client->set_read_timeout(ioTimeout.count());
+        client->set_write_timeout(ioTimeout.count());
+        return client;
+    }
+
+    void HttpConnectionPool::release(std::unique_ptr<httplib::Client> client, bool reusable) {
+        std::unique_ptr<httplib::Client> dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --leased;
+
+            auto now = Clock::now();
+            evictExpired(now);
+            if (reusable) {
+                idle.push_back({std::move(client), now});
+            } else {
+                ++counters.discarded;
+                dropped = std::move(client);
+            }
+        }
+        available.notify_one();
+    }
+
+    void HttpConnectionPool::evictExpired(Clock::time_point now) {
+        // Le connessioni sono in ordine di rilascio: le scadute sono tutte in testa
+        auto firstAlive = std::find_if(idle.begin(), idle.end(), [&](const IdleClient& entry) {
+            return now - entry.lastUsed < idleTimeout;
+        });
+        counters.evicted += static_cast<uint64_t>(firstAlive - idle.begin());
+        idle.erase(idle.begin(), firstAlive);
+    }
+
+} // namespace stl2glb
@@ -0,0 +1,62 @@
+#include "stl2glb/LatencyTracker.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace stl2glb {
+
+    LatencyTracker::LatencyTracker(double percentile) : percentile(percentile) {
+        samples.reserve(WINDOW);
+    }
+
+    void LatencyTracker::record(std::chrono::microseconds firstByte) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (samples.size() < WINDOW) {
+            samples.push_back(firstByte);
+        } else {
+            samples[next] = firstByte;
+            next = (next + 1) % WINDOW;
+        }
+    }
+
+    std::optional<std::chrono::microseconds> LatencyTracker::hedgeDelay() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++requests;
+        if (percentile <= 0.0 || samples.size() < MIN_SAMPLES ||
+            static_cast<double>(hedges) >= HEDGE_BUDGET * static_cast<double>(requests)) {
+            return std::nullopt;
+        }
+        return percentileLocked();
+    }
+
+    void LatencyTracker::hedgeSent() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++hedges;
+    }
+
+    void LatencyTracker::hedgeWon() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++hedgeWins;
+    }
+
+    HedgeStats LatencyTracker::stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        HedgeStats result;
+        result.requests = requests;
+        result.hedges = hedges;
+        result.hedgeWins = hedgeWins;
+        if (percentile > 0.0 && samples.size() >= MIN_SAMPLES) {
+            result.hedgeDelay = percentileLocked();
+        }
+        return result;
+    }
+
+    std::chrono::microseconds LatencyTracker::percentileLocked() const {
+        // Al più WINDOW elementi: copiarli e selezionare costa meno della GET stessa
+        std::vector<std::chrono::microseconds> sorted(samples);
+        size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+        rank = std::min(std::max<size_t>(rank, 1), sorted.size()) - 1;
+        std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(rank), sorted.end());
+        return sorted[rank];
+    }
+
+} // namespace stl2glb
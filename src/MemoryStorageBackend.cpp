@@ -0,0 +1,114 @@
+#include "stl2glb/MemoryStorageBackend.hpp"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace stl2glb {
+
+    namespace {
+        std::string objectKey(const std::string& bucket, const std::string& objectName) {
+            return bucket + "/" + objectName;
+        }
+    }
+
+    MemoryStorageBackend::Object MemoryStorageBackend::find(const std::string& bucket,
+                                                            const std::string& objectName) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = objects.find(objectKey(bucket, objectName));
+        return it == objects.end() ? nullptr : it->second;
+    }
+
+    void MemoryStorageBackend::store(const std::string& bucket, const std::string& objectName, std::string content) {
+        auto object = std::make_shared<const std::string>(std::move(content));
+        std::lock_guard<std::mutex> lock(mutex);
+        objects[objectKey(bucket, objectName)] = std::move(object);
+    }
+
+    void MemoryStorageBackend::get(const std::string& bucket,
+                                   const std::string& objectName,
+                                   const std::string& localPath) {
+        Object object = find(bucket, objectName);
+        if (!object) {
+            throw std::runtime_error("Object not found: " + bucket + "/" + objectName);
+        }
+
+        std::ofstream out(localPath, std::ios::binary | std::ios::trunc);
+        out.write(object->data(), static_cast<std::streamsize>(object->size()));
+        out.close();
+        if (!out) {
+            throw std::runtime_error("Could not write file: " + localPath);
+        }
+    }
+
+    void MemoryStorageBackend::getRange(const std::string& bucket,
+                                        const std::string& objectName,
+                                        uint64_t offset,
+                                        uint64_t length,
+                                        std::string& content) {
+        content.clear();
+        Object object = find(bucket, objectName);
+        if (!object) {
+            throw std::runtime_error("Object not found: " + bucket + "/" + objectName);
+        }
+        if (length == 0) {
+            return;
+        }
+        if (offset >= object->size()) {
+            throw std::runtime_error("Range start " + std::to_string(offset) + " beyond end of " +
+                                     bucket + "/" + objectName);
+        }
+        content.assign(*object, static_cast<size_t>(offset),
+                       static_cast<size_t>(std::min<uint64_t>(length, object->size() - offset)));
+    }
+
+    void MemoryStorageBackend::put(const std::string& bucket,
+                                   const std::string& objectName,
+                                   const std::string& localPath,
+                                   const std::string&) {
+        std::ifstream in(localPath, std::ios::binary | std::ios::ate);
+        if (!in) {
+            throw std::runtime_error("File not found for upload: " + localPath);
+        }
+
+        std::string content(static_cast<size_t>(in.tellg()), '\0');
+        in.seekg(0);
+        if (!in.read(&content[0], static_cast<std::streamsize>(content.size()))) {
+            throw std::runtime_error("Could not read file: " + localPath);
+        }
+        store(bucket, objectName, std::move(content));
+    }
+
+    bool MemoryStorageBackend::head(const std::string& bucket, const std::string& objectName, uint64_t* size) {
+        Object object = find(bucket, objectName);
+        if (!object) {
+            return false;
+        }
+        if (size) {
+            *size = object->size();
+        }
+        return true;
+    }
+
+    bool MemoryStorageBackend::getText(const std::string& bucket,
+                                       const std::string& objectName,
+                                       std::string& content) {
+        Object object = find(bucket, objectName);
+        if (!object) {
+            return false;
+        }
+        content = *object;
+        return true;
+    }
+
+    void MemoryStorageBackend::putText(const std::string& bucket,
+                                       const std::string& objectName,
+                                       const std::string& content) {
+        store(bucket, objectName, content);
+    }
+
+    size_t MemoryStorageBackend::size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return objects.size();
+    }
+
+} // namespace stl2glb
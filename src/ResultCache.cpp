@@ -0,0 +1,146 @@
+#include "stl2glb/ResultCache.hpp"
+#include "stl2glb/Logger.hpp"
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace stl2glb {
+
+    namespace {
+        constexpr const char* INDEX_HEADER = "# stl2glb result cache v1";
+    }
+
+    ResultCache::ResultCache(size_t capacity, std::string indexPath)
+            : capacity(capacity), indexPath(std::move(indexPath)) {
+        if (capacity == 0 || this->indexPath.empty()) return;
+
+        load();
+        openIndex();
+        Logger::info("Result cache loaded " + std::to_string(entries.size()) + " entries from " + this->indexPath);
+    }
+
+    ResultCache::~ResultCache() {
+        if (index) {
+            std::fclose(index);
+        }
+    }
+
+    std::optional<std::string> ResultCache::lookup(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = positions.find(key);
+        if (it == positions.end()) {
+            return std::nullopt;
+        }
+
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->second;
+    }
+
+    void ResultCache::store(const std::string& key, const std::string& value) {
+        if (capacity == 0) return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        insert(key, value);
+
+        if (!index) return;
+
+        // Una riga per inserimento, resa subito visibile a un eventuale riavvio
+        std::fprintf(index, "%s\t%s\n", key.c_str(), value.c_str());
+        if (std::fflush(index) != 0) {
+            Logger::warn("Failed to append to result cache index: " + indexPath);
+        }
+
+        if (++indexLines > 2 * capacity) {
+            compact();
+        }
+    }
+
+    size_t ResultCache::size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+    void ResultCache::insert(const std::string& key, const std::string& value) {
+        auto it = positions.find(key);
+        if (it != positions.end()) {
+            it->second->second = value;
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+
+        entries.emplace_front(key, value);
+        positions[key] = entries.begin();
+
+        if (entries.size() > capacity) {
+            positions.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+    void ResultCache::load() {
+        std::ifstream in(indexPath);
+        if (!in) return;
+
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+
+            size_t tab = line.find('\t');
+            if (tab == std::string::npos || tab == 0 || tab + 1 == line.size()) {
+                continue;  // Riga troncata da un arresto durante la scrittura
+            }
+
+            insert(line.substr(0, tab), line.substr(tab + 1));
+            ++indexLines;
+        }
+    }
+
+    void ResultCache::openIndex() {
+        std::filesystem::path path(indexPath);
+        if (path.has_parent_path()) {
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+
+        bool fresh = !std::filesystem::exists(path);
+        index = std::fopen(indexPath.c_str(), "a");
+        if (!index) {
+            Logger::warn("Cannot open result cache index " + indexPath + " (" + std::strerror(errno) +
+                         "), cache will not persist");
+            return;
+        }
+
+        if (fresh) {
+            std::fprintf(index, "%s\n", INDEX_HEADER);
+            std::fflush(index);
+        }
+    }
+
+    void ResultCache::compact() {
+        std::string tmpPath = indexPath + ".tmp";
+        std::FILE* out = std::fopen(tmpPath.c_str(), "w");
+        if (!out) {
+            Logger::warn("Cannot compact result cache index: " + indexPath);
+            return;
+        }
+
+        // Dalla voce meno recente alla più recente, così il ricaricamento conserva l'ordine LRU
+        std::fprintf(out, "%s\n", INDEX_HEADER);
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+            std::fprintf(out, "%s\t%s\n", it->first.c_str(), it->second.c_str());
+        }
+
+        if (std::fclose(out) != 0 || std::rename(tmpPath.c_str(), indexPath.c_str()) != 0) {
+            Logger::warn("Cannot compact result cache index: " + indexPath);
+            std::remove(tmpPath.c_str());
+            return;
+        }
+
+        std::fclose(index);
+        index = std::fopen(indexPath.c_str(), "a");
+        indexLines = entries.size();
+    }
+
+} // namespace stl2glb
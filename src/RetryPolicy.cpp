@@ -0,0 +1,37 @@
+#include "stl2glb/RetryPolicy.hpp"
+#include <algorithm>
+#include <random>
+
+namespace stl2glb {
+
+    RetryPolicy::RetryPolicy(unsigned int retries,
+                             std::chrono::milliseconds baseDelay,
+                             std::chrono::milliseconds maxDelay)
+            : maxRetries(retries), baseDelay(baseDelay), maxDelay(maxDelay) {}
+
+    bool RetryPolicy::retryableStatus(int status) {
+        return status >= 500 || status == 429 || status == 408;
+    }
+
+    void RetryPolicy::throwForStatus(const std::string& message, int status) {
+        std::string error = message + ": " + std::to_string(status);
+        if (retryableStatus(status)) {
+            throw RetryableError(error);
+        }
+        throw std::runtime_error(error);
+    }
+
+    std::chrono::milliseconds RetryPolicy::backoff(unsigned int attempt) const {
+        // Limite prima dello shift, per non andare in overflow con molti tentativi
+        long long ceiling = baseDelay.count() << std::min(attempt, 20u);
+        ceiling = std::min<long long>(ceiling, maxDelay.count());
+        if (ceiling <= 0) {
+            return std::chrono::milliseconds(0);
+        }
+
+        thread_local std::mt19937_64 generator{std::random_device{}()};
+        std::uniform_int_distribution<long long> distribution(0, ceiling);
+        return std::chrono::milliseconds(distribution(generator));
+    }
+
+} // namespace stl2glb
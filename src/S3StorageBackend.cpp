@@ -0,0 +1,43 @@
+#include "stl2glb/S3StorageBackend.hpp"
+#include "stl2glb/MinioClient.hpp"
+
+namespace stl2glb {
+
+    void S3StorageBackend::get(const std::string& bucket,
+                               const std::string& objectName,
+                               const std::string& localPath) {
+        MinioClient::download(bucket, objectName, localPath);
+    }
+
+    void S3StorageBackend::getRange(const std::string& bucket,
+                                    const std::string& objectName,
+                                    uint64_t offset,
+                                    uint64_t length,
+                                    std::string& content) {
+        MinioClient::getRange(bucket, objectName, offset, length, content);
+    }
+
+    void S3StorageBackend::put(const std::string& bucket,
+                               const std::string& objectName,
+                               const std::string& localPath,
+                               const std::string& payloadSha256) {
+        MinioClient::upload(bucket, objectName, localPath, payloadSha256);
+    }
+
+    bool S3StorageBackend::head(const std::string& bucket, const std::string& objectName, uint64_t* size) {
+        return MinioClient::exists(bucket, objectName, size);
+    }
+
+    bool S3StorageBackend::getText(const std::string& bucket,
+                                   const std::string& objectName,
+                                   std::string& content) {
+        return MinioClient::getText(bucket, objectName, content);
+    }
+
+    void S3StorageBackend::putText(const std::string& bucket,
+                                   const std::string& objectName,
+                                   const std::string& content) {
+        MinioClient::putText(bucket, objectName, content);
+    }
+
+} // namespace stl2glb
@@ -1,5 +1,7 @@
 #include "stl2glb/STLParser.hpp"
 #include "stl2glb/Logger.hpp"
+#include "stl2glb/TriangleKernel.hpp"
+#include "stl2glb/Parallel.hpp"
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -11,6 +13,9 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <charconv>
+#include <string>
+#include <string_view>
 
 
 // Platform-specific includes per memory mapping
@@ -104,158 +109,384 @@ namespace stl2glb {
 
         const void* getData() const { return data; }
         size_t getSize() const { return size; }
+
+        // Rilascia le pagine già lette di [0, end): restano nella page cache ma
+        // non contano più nella memoria residente del processo
+        void releaseBefore(size_t end) {
+#ifndef _WIN32
+            size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            size_t length = std::min(end, size) / pageSize * pageSize;
+            if (length > 0) {
+                madvise(data, length, MADV_DONTNEED);
+            }
+#else
+            (void)end;
+#endif
+        }
     };
 
+    namespace {
+        constexpr size_t BINARY_HEADER_SIZE = 84;
+
+        // Intervallo della Mesh elaborato da un singolo thread: i triangoli validi
+        // sono scritti a partire da slot, compattati poi in ordine
+        struct ChunkResult {
+            size_t slot = 0;
+            size_t written = 0;
+            std::vector<uint32_t> skipped;
+        };
+
+        // Compattazione ordinata delle slice: i triangoli e gli scarti
+        // mantengono lo stesso ordine del parse sequenziale
+        void compactChunks(Mesh& mesh, std::vector<ChunkResult>& chunks) {
+            size_t total = 0;
+            for (const auto& chunk : chunks) {
+                for (uint32_t index : chunk.skipped) {
+                    Logger::warn("Invalid triangle at index " + std::to_string(index) + ", skipping");
+                }
+                mesh.moveTriangles(chunk.slot, total, chunk.written);
+                total += chunk.written;
+            }
+            mesh.resize(total);
+        }
+    }
+
     // In STLParser.cpp - Parser binario corretto
     class OptimizedBinaryParser {
     private:
         const uint8_t* data;
         size_t size;
 
-        // Metodo corretto per leggere triangoli STL binari
-        Triangle readTriangle(size_t offset) const {
-            Triangle tri;
+    public:
+        OptimizedBinaryParser(const void* fileData, size_t fileSize)
+                : data(static_cast<const uint8_t*>(fileData)), size(fileSize) {}
+
+        Mesh parse() {
+            uint32_t numTriangles = readTriangleCount();
+
+            // Ogni thread scrive direttamente nella propria slice della Mesh finale
+            Mesh mesh;
+            mesh.resize(numTriangles);
+
+            unsigned numThreads = Parallel::threadCount(numTriangles, MIN_TRIANGLES_PER_THREAD);
+
+            std::vector<ChunkResult> chunks(numThreads);
+            if (numThreads > 1) {
+                Logger::info("Parallel parsing on " + std::to_string(numThreads) + " threads");
+            }
 
-            // Usa la struttura raw per leggere esattamente 50 bytes
-            STLTriangleRaw raw;
-            std::memcpy(&raw, data + offset, sizeof(STLTriangleRaw));
+            Parallel::run(numThreads, [&](size_t t) {
+                auto range = Parallel::blockRange(t, numThreads, numTriangles);
+                parseRange(static_cast<uint32_t>(range.first), static_cast<uint32_t>(range.second),
+                           mesh, chunks[t]);
+            });
 
-            // Copia i dati nella struttura Triangle non-packed
-            std::memcpy(tri.normal, raw.normal, sizeof(tri.normal));
-            std::memcpy(tri.vertex1, raw.vertex1, sizeof(tri.vertex1));
-            std::memcpy(tri.vertex2, raw.vertex2, sizeof(tri.vertex2));
-            std::memcpy(tri.vertex3, raw.vertex3, sizeof(tri.vertex3));
-            tri.attributeByteCount = raw.attributeByteCount;
+            compactChunks(mesh, chunks);
 
-            return tri;
+            Logger::info("Successfully parsed " + std::to_string(mesh.triangleCount()) + " valid triangles");
+            return mesh;
         }
 
-    public:
-        OptimizedBinaryParser(const void* fileData, size_t fileSize)
-                : data(static_cast<const uint8_t*>(fileData)), size(fileSize) {}
+        // Validazione e saldatura esatta a blocchi durante la lettura sequenziale del file;
+        // le pagine del file già elaborate vengono rilasciate man mano
+        IndexedMesh parseWelded(MemoryMappedFile& file) {
+            uint32_t numTriangles = readTriangleCount();
+
+            WeldAccumulator accumulator(numTriangles, true);
+            AlignedBuffer<float> positions(FUSED_BATCH * Mesh::FLOATS_PER_TRIANGLE);
+            AlignedBuffer<float> normals(FUSED_BATCH * Mesh::FLOATS_PER_NORMAL);
+            std::vector<uint32_t> skipped;
+            size_t valid = 0;
+
+            for (uint32_t begin = 0; begin < numTriangles; begin += FUSED_BATCH) {
+                uint32_t count = std::min<uint32_t>(FUSED_BATCH, numTriangles - begin);
+                const uint8_t* records = data + BINARY_HEADER_SIZE + (static_cast<size_t>(begin) * 50);
+
+                skipped.clear();
+                size_t written = TriangleKernel::process(records, count, positions.data(), normals.data(),
+                                                         skipped, begin);
+                for (uint32_t index : skipped) {
+                    Logger::warn("Invalid triangle at index " + std::to_string(index) + ", skipping");
+                }
+
+                accumulator.addTriangles(positions.data(), normals.data(), written);
+                valid += written;
 
-        std::vector<Triangle> parse() {
-            if (size < 84) {
+                if ((begin / FUSED_BATCH) % RELEASE_EVERY_BATCHES == RELEASE_EVERY_BATCHES - 1) {
+                    file.releaseBefore(BINARY_HEADER_SIZE + (static_cast<size_t>(begin) + count) * 50);
+                }
+            }
+
+            Logger::info("Successfully parsed " + std::to_string(valid) + " valid triangles");
+            return accumulator.finish();
+        }
+
+    private:
+        // Sotto questa soglia il costo di avvio dei thread supera il guadagno
+        static constexpr size_t MIN_TRIANGLES_PER_THREAD = 64 * 1024;
+
+        // Blocco del parse fuso: 4096 triangoli, 192 KB di posizioni e normali in cache L2
+        static constexpr uint32_t FUSED_BATCH = 4096;
+
+        // Rilascio delle pagine lette ogni 16 blocchi (circa 3 MB di file)
+        static constexpr uint32_t RELEASE_EVERY_BATCHES = 16;
+
+        // Header STL binario (80 bytes) + numero triangoli (4 bytes), con validazione della dimensione
+        uint32_t readTriangleCount() const {
+            if (size < BINARY_HEADER_SIZE) {
                 throw std::runtime_error("STL file too small");
             }
 
-            // Header STL binario (80 bytes) + numero triangoli (4 bytes)
             uint32_t numTriangles;
             std::memcpy(&numTriangles, data + 80, sizeof(uint32_t));
 
             Logger::info("Parsing STL with " + std::to_string(numTriangles) + " triangles");
 
             // Validazione dimensione file
-            size_t expectedSize = 84 + (static_cast<size_t>(numTriangles) * 50);
+            size_t expectedSize = BINARY_HEADER_SIZE + (static_cast<size_t>(numTriangles) * 50);
             if (size < expectedSize) {
                 throw std::runtime_error("STL file truncated. Expected " +
                                          std::to_string(expectedSize) + " bytes, got " + std::to_string(size));
             }
+            return numTriangles;
+        }
 
-            std::vector<Triangle> triangles;
-            triangles.reserve(numTriangles);
+        // Valida e corregge i triangoli [begin, end) nella slice di output del chiamante
+        void parseRange(uint32_t begin, uint32_t end, Mesh& mesh, ChunkResult& out) const {
+            const uint8_t* records = data + BINARY_HEADER_SIZE + (static_cast<size_t>(begin) * 50);
+            float* normals = mesh.normals();
+
+            out.slot = begin;
+            out.written = TriangleKernel::process(
+                    records, end - begin,
+                    mesh.positions() + out.slot * Mesh::FLOATS_PER_TRIANGLE,
+                    normals ? normals + out.slot * Mesh::FLOATS_PER_NORMAL : nullptr,
+                    out.skipped, begin);
+        }
+    };
 
-            // Parse sequenziale per evitare problemi di threading
-            for (uint32_t i = 0; i < numTriangles; ++i) {
-                size_t offset = 84 + (i * 50);
-                Triangle tri = readTriangle(offset);
+    // Parser ASCII: "solid ... facet normal ... outer loop ... vertex ... endloop endfacet ... endsolid".
+    // Il file viene diviso in intervalli che iniziano sempre su un token "facet",
+    // ogni thread produce i record grezzi del proprio intervallo e li passa al
+    // TriangleKernel, così la validazione è identica a quella del formato binario.
+    class AsciiParser {
+    private:
+        const char* data;
+        size_t size;
 
-                // Validazione base dei dati
-                if (!isValidTriangle(tri)) {
-                    Logger::warn("Invalid triangle at index " + std::to_string(i) + ", skipping");
-                    continue;
-                }
+    public:
+        AsciiParser(const void* fileData, size_t fileSize)
+                : data(static_cast<const char*>(fileData)), size(fileSize) {}
+
+        Mesh parse() {
+            // La prima riga ("solid <nome>") può contenere qualsiasi testo
+            const char* lineEnd = static_cast<const char*>(std::memchr(data, '\n', size));
+            size_t bodyStart = lineEnd ? static_cast<size_t>(lineEnd - data) + 1 : size;
+
+            unsigned numThreads = Parallel::threadCount(size - bodyStart, MIN_BYTES_PER_THREAD);
+
+            // Confini degli intervalli allineati all'inizio di una facet
+            std::vector<size_t> bounds(numThreads + 1);
+            bounds[0] = findFacet(bodyStart);
+            for (unsigned t = 1; t < numThreads; ++t) {
+                size_t guess = bodyStart + (size - bodyStart) * t / numThreads;
+                bounds[t] = std::max(bounds[t - 1], findFacet(guess));
+            }
+            bounds[numThreads] = size;
+
+            // Prima fase: tokenizzazione in record grezzi, il numero di facet
+            // per intervallo è noto solo alla fine
+            std::vector<std::vector<STLTriangleRaw>> records(numThreads);
+            auto tokenize = [&](size_t t) {
+                parseRange(bounds[t], bounds[t + 1], records[t]);
+            };
+
+            if (numThreads > 1) {
+                Logger::info("Parallel ASCII parsing on " + std::to_string(numThreads) + " threads");
+            }
+            Parallel::run(numThreads, tokenize);
 
-                // Correggi normale se necessaria
-                validateAndFixNormal(tri);
-                triangles.push_back(tri);
+            std::vector<ChunkResult> chunks(numThreads);
+            size_t numFacets = 0;
+            for (unsigned t = 0; t < numThreads; ++t) {
+                chunks[t].slot = numFacets;
+                numFacets += records[t].size();
             }
 
-            Logger::info("Successfully parsed " + std::to_string(triangles.size()) + " valid triangles");
-            return triangles;
+            Logger::info("Parsing ASCII STL with " + std::to_string(numFacets) + " facets");
+
+            // Seconda fase: validazione nelle slice della Mesh finale
+            Mesh mesh;
+            mesh.resize(numFacets);
+
+            auto validate = [&](size_t t) {
+                float* normals = mesh.normals();
+                ChunkResult& chunk = chunks[t];
+                chunk.written = TriangleKernel::process(
+                        reinterpret_cast<const uint8_t*>(records[t].data()), records[t].size(),
+                        mesh.positions() + chunk.slot * Mesh::FLOATS_PER_TRIANGLE,
+                        normals ? normals + chunk.slot * Mesh::FLOATS_PER_NORMAL : nullptr,
+                        chunk.skipped, static_cast<uint32_t>(chunk.slot));
+                std::vector<STLTriangleRaw>().swap(records[t]);
+            };
+
+            Parallel::run(numThreads, validate);
+
+            compactChunks(mesh, chunks);
+
+            Logger::info("Successfully parsed " + std::to_string(mesh.triangleCount()) + " valid triangles");
+            return mesh;
         }
 
     private:
-        bool isValidTriangle(const Triangle& tri) const {
-            // Verifica che i vertici non siano NaN o infiniti
+        // Ogni facet occupa circa 250 byte: ~64K facet per thread come nel binario
+        static constexpr size_t MIN_BYTES_PER_THREAD = 16 * 1024 * 1024;
+
+        static bool isSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+        }
+
+        // Posizione del prossimo token "facet" (non "endfacet") a partire da from
+        size_t findFacet(size_t from) const {
+            static constexpr char keyword[] = "facet";
+            static constexpr size_t keywordLen = sizeof(keyword) - 1;
+
+            const std::string_view text(data, size);
+            while (from + keywordLen <= size) {
+                size_t pos = text.find(keyword, from, keywordLen);
+                if (pos == std::string_view::npos) break;
+
+                bool startsToken = pos == 0 || isSpace(data[pos - 1]);
+                bool endsToken = pos + keywordLen == size || isSpace(data[pos + keywordLen]);
+                if (startsToken && endsToken) return pos;
+
+                from = pos + keywordLen;
+            }
+            return size;
+        }
+
+        const char* skipSpace(const char* p, const char* end) const {
+            while (p < end && isSpace(*p)) ++p;
+            return p;
+        }
+
+        void expectKeyword(const char*& p, const char* end, const char* keyword) const {
+            p = skipSpace(p, end);
+            size_t len = std::strlen(keyword);
+            if (static_cast<size_t>(end - p) < len || std::memcmp(p, keyword, len) != 0 ||
+                (p + len < end && !isSpace(p[len]))) {
+                throw std::runtime_error(std::string("Malformed ASCII STL: expected '") + keyword +
+                                         "' at byte " + std::to_string(p - data));
+            }
+            p += len;
+        }
+
+        void readFloats(const char*& p, const char* end, float* out) const {
             for (int i = 0; i < 3; ++i) {
-                if (!std::isfinite(tri.vertex1[i]) || !std::isfinite(tri.vertex2[i]) ||
-                    !std::isfinite(tri.vertex3[i])) {
-                    return false;
+                p = skipSpace(p, end);
+                // from_chars non accetta il segno '+' esplicito
+                if (p < end && *p == '+') ++p;
+
+                auto result = std::from_chars(p, end, out[i]);
+                if (result.ec != std::errc() || (result.ptr < end && !isSpace(*result.ptr))) {
+                    throw std::runtime_error("Malformed ASCII STL: invalid number at byte " +
+                                             std::to_string(p - data));
                 }
+                p = result.ptr;
             }
+        }
 
-            // Verifica che il triangolo non sia degenere (area > 0)
-            float v1[3] = {
-                    tri.vertex2[0] - tri.vertex1[0],
-                    tri.vertex2[1] - tri.vertex1[1],
-                    tri.vertex2[2] - tri.vertex1[2]
-            };
-            float v2[3] = {
-                    tri.vertex3[0] - tri.vertex1[0],
-                    tri.vertex3[1] - tri.vertex1[1],
-                    tri.vertex3[2] - tri.vertex1[2]
-            };
+        // Legge tutte le facet che iniziano in [begin, end); l'ultima può terminare oltre end
+        void parseRange(size_t begin, size_t end, std::vector<STLTriangleRaw>& out) const {
+            const char* fileEnd = data + size;
+            size_t pos = begin;
+
+            while (pos < end) {
+                const char* p = data + pos;
+
+                // Normale e tre vertici nello stesso ordine del record binario
+                float fields[12];
+                expectKeyword(p, fileEnd, "facet");
+                expectKeyword(p, fileEnd, "normal");
+                readFloats(p, fileEnd, fields);
+                expectKeyword(p, fileEnd, "outer");
+                expectKeyword(p, fileEnd, "loop");
+                for (int v = 1; v <= 3; ++v) {
+                    expectKeyword(p, fileEnd, "vertex");
+                    readFloats(p, fileEnd, fields + v * 3);
+                }
+                expectKeyword(p, fileEnd, "endloop");
+                expectKeyword(p, fileEnd, "endfacet");
 
-            // Cross product per area
-            float cross[3] = {
-                    v1[1] * v2[2] - v1[2] * v2[1],
-                    v1[2] * v2[0] - v1[0] * v2[2],
-                    v1[0] * v2[1] - v1[1] * v2[0]
-            };
+                STLTriangleRaw raw;
+                std::memcpy(&raw, fields, sizeof(fields));
+                raw.attributeByteCount = 0;
+                out.push_back(raw);
 
-            float area = std::sqrt(cross[0]*cross[0] + cross[1]*cross[1] + cross[2]*cross[2]);
-            return area > 1e-6f; // Triangolo valido se area > epsilon
+                pos = findFacet(static_cast<size_t>(p - data));
+            }
         }
+    };
 
-        void validateAndFixNormal(Triangle& tri) const {
-            float normalLen = std::sqrt(
-                    tri.normal[0] * tri.normal[0] +
-                    tri.normal[1] * tri.normal[1] +
-                    tri.normal[2] * tri.normal[2]
-            );
-
-            // Se la normale è invalida o zero, ricalcolala
-            if (normalLen < 0.1f || !std::isfinite(normalLen)) {
-                // Calcola normale dal prodotto vettoriale
-                float v1[3] = {
-                        tri.vertex2[0] - tri.vertex1[0],
-                        tri.vertex2[1] - tri.vertex1[1],
-                        tri.vertex2[2] - tri.vertex1[2]
-                };
-                float v2[3] = {
-                        tri.vertex3[0] - tri.vertex1[0],
-                        tri.vertex3[1] - tri.vertex1[1],
-                        tri.vertex3[2] - tri.vertex1[2]
-                };
-
-                tri.normal[0] = v1[1] * v2[2] - v1[2] * v2[1];
-                tri.normal[1] = v1[2] * v2[0] - v1[0] * v2[2];
-                tri.normal[2] = v1[0] * v2[1] - v1[1] * v2[0];
-
-                float len = std::sqrt(
-                        tri.normal[0] * tri.normal[0] +
-                        tri.normal[1] * tri.normal[1] +
-                        tri.normal[2] * tri.normal[2]
-                );
-
-                if (len > 1e-6f) {
-                    tri.normal[0] /= len;
-                    tri.normal[1] /= len;
-                    tri.normal[2] /= len;
-                } else {
-                    // Normale default se il triangolo è degenere
-                    tri.normal[0] = 0.0f;
-                    tri.normal[1] = 0.0f;
-                    tri.normal[2] = 1.0f;
+    namespace {
+        // Alcuni esportatori binari scrivono "solid" nell'header: il formato
+        // binario viene riconosciuto prima di tutto dalla dimensione esatta
+        bool isAsciiStl(const char* data, size_t size) {
+            if (size >= BINARY_HEADER_SIZE) {
+                uint32_t numTriangles;
+                std::memcpy(&numTriangles, data + 80, sizeof(uint32_t));
+                if (BINARY_HEADER_SIZE + static_cast<size_t>(numTriangles) * 50 == size) {
+                    return false;
                 }
-            } else {
-                // Normalizza la normale esistente
-                tri.normal[0] /= normalLen;
-                tri.normal[1] /= normalLen;
-                tri.normal[2] /= normalLen;
             }
+
+            size_t pos = 0;
+            while (pos < size && std::isspace(static_cast<unsigned char>(data[pos]))) ++pos;
+            if (size - pos < 5 || std::memcmp(data + pos, "solid", 5) != 0) {
+                return false;
+            }
+
+            // Un file ASCII non contiene byte nulli e ha una facet (o endsolid) in testa
+            size_t probe = std::min<size_t>(size, 1024);
+            if (std::memchr(data, '\0', probe)) {
+                return false;
+            }
+            std::string head(data, probe);
+            return head.find("facet") != std::string::npos || head.find("endsolid") != std::string::npos;
         }
-    };
+    }
+
+    Mesh STLParser::parse(const std::string& path) {
+        MemoryMappedFile file(path);
+        const char* data = static_cast<const char*>(file.getData());
+
+        if (isAsciiStl(data, file.getSize())) {
+            Logger::info("Detected ASCII STL format");
+            AsciiParser parser(data, file.getSize());
+            return parser.parse();
+        }
+
+        OptimizedBinaryParser parser(data, file.getSize());
+        return parser.parse();
+    }
+
+    IndexedMesh STLParser::parseWelded(const std::string& path, const ConversionOptions& options) {
+        bool fused = options.fusedParse && options.weldMode == WeldMode::Exact;
+
+        if (fused) {
+            MemoryMappedFile file(path);
+            const char* data = static_cast<const char*>(file.getData());
+
+            if (!isAsciiStl(data, file.getSize())) {
+                Logger::info("Fused binary parse and weld");
+                OptimizedBinaryParser parser(data, file.getSize());
+                return parser.parseWelded(file);
+            }
+        }
+
+        // Percorso in due passate: ASCII, saldatura con tolleranza o parse fuso disattivato
+        Mesh mesh = parse(path);
+        return VertexWelder::weld(mesh, options);
+    }
 
-} // namespace stl2glb
\ No newline at end of file
+} // namespace stl2glb
@@ -1,6 +1,11 @@
 #include "stl2glb/Server.hpp"
 #include "stl2glb/Converter.hpp"
+#include "stl2glb/EnvironmentHandler.hpp"
 #include "stl2glb/Logger.hpp"
+#include "stl2glb/MinioClient.hpp"
+#include "stl2glb/ResultCache.hpp"
+#include "stl2glb/SingleFlight.hpp"
+#include "stl2glb/StorageBackend.hpp"
 #include <httplib.h>
 
 #include <nlohmann/json.hpp>
@@ -10,9 +15,76 @@ using json = nlohmann::json;
 
 namespace stl2glb {
 
+    namespace {
+        // Prefisso degli oggetti indice nel bucket GLB (contenuto: glb_hash)
+        const std::string CACHE_MIRROR_PREFIX = "cache/";
+
+        // Converter::run preceduto dalla cache dei risultati (memoria, poi indice nel bucket
+        // se abilitato) e deduplicato: richieste concorrenti con la stessa chiave attendono
+        // un'unica conversione. Le conversioni nuove vengono registrate nella cache.
+        std::string convertCached(ResultCache& cache, SingleFlight& flights,
+                                  const std::string& stl_hash, const ConversionOptions& options) {
+            auto& env = EnvironmentHandler::instance();
+            std::string key = Converter::cacheKey(stl_hash, options);
+
+            if (auto cached = cache.lookup(key)) {
+                Logger::info("Result cache hit for STL hash: " + stl_hash);
+                return *cached;
+            }
+
+            bool shared = false;
+            std::string glb_hash = flights.run(key, [&]() -> std::string {
+                if (!cache.enabled()) {
+                    return Converter::run(stl_hash, options);
+                }
+
+                // Una conversione identica può essersi conclusa dopo il primo controllo
+                if (auto cached = cache.lookup(key)) {
+                    return *cached;
+                }
+
+                if (env.mirrorResultCache()) {
+                    try {
+                        std::string mirrored;
+                        if (StorageBackend::instance().getText(env.getGlbBucketName(), CACHE_MIRROR_PREFIX + key, mirrored) &&
+                            !mirrored.empty()) {
+                            Logger::info("Result cache bucket hit for STL hash: " + stl_hash);
+                            cache.store(key, mirrored);
+                            return mirrored;
+                        }
+                    } catch (const std::exception& e) {
+                        Logger::warn("Result cache mirror lookup failed: " + std::string(e.what()));
+                    }
+                }
+
+                std::string converted = Converter::run(stl_hash, options);
+                cache.store(key, converted);
+
+                if (env.mirrorResultCache()) {
+                    try {
+                        StorageBackend::instance().putText(env.getGlbBucketName(), CACHE_MIRROR_PREFIX + key, converted);
+                    } catch (const std::exception& e) {
+                        Logger::warn("Result cache mirror update failed: " + std::string(e.what()));
+                    }
+                }
+
+                return converted;
+            }, &shared);
+
+            if (shared) {
+                Logger::info("Joined in-flight conversion for STL hash: " + stl_hash);
+            }
+            return glb_hash;
+        }
+    }
+
     void Server::start(int port) {
         httplib::Server svr;
 
+        auto& env = EnvironmentHandler::instance();
+        ResultCache cache(env.getResultCacheSize(), env.getResultCacheIndexPath());
+        SingleFlight flights;
+
         std::cout << "[stl2glb] Server started on port " << port << std::endl;
 
         // Health check endpoint
@@ -20,14 +92,60 @@ namespace stl2glb {
             res.set_content("{\"status\":\"healthy\",\"service\":\"stl2glb\"}", "application/json");
         });
 
+        // Statistiche di cache, conversioni in corso e, con il backend S3, pool di connessioni e GET duplicate
+        svr.Get("/stats", [&cache, &flights](const httplib::Request&, httplib::Response& res) {
+            json stats = {
+                    {"result_cache_entries", cache.size()},
+                    {"conversions_in_flight", flights.inFlight()},
+                    {"storage", StorageBackend::instance().name()}
+            };
+            if (EnvironmentHandler::instance().getStorageType() == StorageType::S3) {
+                auto pool = MinioClient::poolStats();
+                auto hedge = MinioClient::hedgeStats();
+                stats["minio_pool"] = {
+                        {"created", pool.created},
+                        {"reused", pool.reused},
+                        {"evicted", pool.evicted},
+                        {"discarded", pool.discarded},
+                        {"waits", pool.waits},
+                        {"idle", pool.idle},
+                        {"leased", pool.leased}
+                };
+                stats["minio_hedged_gets"] = {
+                        {"requests", hedge.requests},
+                        {"hedges", hedge.hedges},
+                        {"hedge_wins", hedge.hedgeWins},
+                        {"hedge_delay_us", hedge.hedgeDelay.count()}
+                };
+            }
+            res.set_content(stats.dump(), "application/json");
+        });
+
         // Convert endpoint
-        svr.Post("/convert", [](const httplib::Request& req, httplib::Response& res) {
+        svr.Post("/convert", [&cache, &flights](const httplib::Request& req, httplib::Response& res) {
             stl2glb::Logger::info("Received /convert POST request");
             try {
                 auto body = json::parse(req.body);
                 std::string stl_hash = body.at("stl_hash");
 
-                std::string glb_hash = Converter::run(stl_hash);
+                // Opzionali: "weld" ("exact" | "tolerance"), "weld_tolerance" (unità del file)
+                // e "fused_parse" (parse e saldatura in una passata, default true)
+                ConversionOptions options;
+                if (body.contains("weld")) {
+                    options.weldMode = ConversionOptions::weldModeFromString(body.at("weld").get<std::string>());
+                }
+                if (body.contains("weld_tolerance")) {
+                    options.weldTolerance = body.at("weld_tolerance").get<float>();
+                    if (options.weldTolerance < 0.0f) {
+                        throw std::runtime_error("weld_tolerance must not be negative");
+                    }
+                }
+
+                if (body.contains("fused_parse")) {
+                    options.fusedParse = body.at("fused_parse").get<bool>();
+                }
+
+                std::string glb_hash = convertCached(cache, flights, stl_hash, options);
 
                 res.set_content(json{{"glb_hash", glb_hash}}.dump(), "application/json");
             } catch (const std::exception& e) {
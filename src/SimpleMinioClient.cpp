@@ -1,37 +1,281 @@
 #include "stl2glb/SimpleMinioClient.hpp"
 #include "stl2glb/EnvironmentHandler.hpp"
+#include "stl2glb/Hasher.hpp"
+#include "stl2glb/Parallel.hpp"
+#include "stl2glb/RetryPolicy.hpp"
 #include <chrono>
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <string.h>
 #include <vector>
 #include <sstream>
-#include <openssl/evp.h>
+#include <thread>
 #include <memory>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace stl2glb {
 
-    std::string SimpleMinioClient::endpoint;
-    std::string SimpleMinioClient::accessKey;
-    std::string SimpleMinioClient::secretKey;
-    std::mutex SimpleMinioClient::clientMutex;
-    bool SimpleMinioClient::initialized = false;
+    namespace {
+        // Corpo massimo conservato di una risposta di errore
+        constexpr size_t MAX_ERROR_BODY = 64 * 1024;
 
-    void SimpleMinioClient::initialize() {
-        std::lock_guard<std::mutex> lock(clientMutex);
-        if (initialized) return;
+        std::string stripScheme(const std::string& endpoint) {
+            if (endpoint.find("http://") == 0) return endpoint.substr(7);
+            if (endpoint.find("https://") == 0) return endpoint.substr(8);
+            return endpoint;
+        }
 
-        auto& env = EnvironmentHandler::instance();
+        // Contenuto del primo elemento <tag> di una risposta XML S3 (vuoto se assente)
+        std::string xmlValue(const std::string& xml, const std::string& tag) {
+            std::string open = "<" + tag + ">";
+            size_t begin = xml.find(open);
+            if (begin == std::string::npos) return "";
+            begin += open.size();
+            size_t end = xml.find("</" + tag + ">", begin);
+            return end == std::string::npos ? "" : xml.substr(begin, end - begin);
+        }
+
+/**
+ * @class DownloadFile
+ * @brief Destinazione di un download in streaming
+ *
+ * Lo spazio viene riservato in anticipo (posix_fallocate) quando la dimensione
+ * è nota e i blocchi ricevuti vengono scritti direttamente con write(). Se il
+ * download non viene completato con finish() il file parziale viene rimosso.
+ */
+        class DownloadFile {
+        public:
+            explicit DownloadFile(const std::string& path) : path(path) {
+#ifdef _WIN32
+                out.open(path, std::ios::binary | std::ios::trunc);
+                if (!out) {
+#else
+                fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+                if (fd == -1) {
+#endif
+                    throw std::runtime_error("Could not open file for writing: " + path);
+                }
+            }
+
+            ~DownloadFile() {
+                if (finished) return;
+#ifdef _WIN32
+                out.close();
+#else
+                ::close(fd);
+#endif
+                std::remove(path.c_str());
+            }
+
+            DownloadFile(const DownloadFile&) = delete;
+            DownloadFile& operator=(const DownloadFile&) = delete;
+
+            void preallocate(uint64_t size) {
+#ifndef _WIN32
+                // Blocchi contigui e nessun ENOSPC a metà download; se il filesystem
+                // non lo supporta si prosegue senza
+                if (size > 0 && posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0) {
+                    reserved = size;
+                }
+#else
+                (void)size;
+#endif
+            }
+
+            // Riparte dall'inizio del file (nuovo tentativo dopo un corpo interrotto)
+            void rewind() {
+#ifdef _WIN32
+                out.clear();
+                out.seekp(0);
+#else
+                if (written > 0 && ::lseek(fd, 0, SEEK_SET) == -1) {
+                    throw std::runtime_error("Could not rewind " + path + ": " + std::strerror(errno));
+                }
+                written = 0;
+#endif
+            }
+
+            // Dimensione finale nota in anticipo, per scritture posizionali (writeAt)
+            void setSize(uint64_t size) {
+#ifndef _WIN32
+                if (posix_fallocate(fd, 0, static_cast<off_t>(size)) != 0 &&
+                    ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                    throw std::runtime_error("Could not allocate " + std::to_string(size) + " bytes for " + path);
+                }
+                reserved = size;
+                written = size;
+#else
+                (void)size;
+#endif
+            }
+
+#ifndef _WIN32
+            // Scrittura all'offset indicato; sicura da più thread su intervalli disgiunti
+            bool writeAt(uint64_t offset, const char* data, size_t size) {
+                while (size > 0) {
+                    ssize_t n = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+                    if (n < 0) {
+                        if (errno == EINTR) continue;
+                        Logger::error("Write failed on " + path + ": " + std::strerror(errno));
+                        return false;
+                    }
+                    data += n;
+                    size -= static_cast<size_t>(n);
+                    offset += static_cast<uint64_t>(n);
+                }
+                return true;
+            }
+#endif
+
+            bool write(const char* data, size_t size) {
+#ifdef _WIN32
+                out.write(data, static_cast<std::streamsize>(size));
+                if (!out) return false;
+#else
+                while (size > 0) {
+                    ssize_t n = ::write(fd, data, size);
+                    if (n < 0) {
+                        if (errno == EINTR) continue;
+                        Logger::error("Write failed on " + path + ": " + std::strerror(errno));
+                        return false;
+                    }
+                    data += n;
+                    size -= static_cast<size_t>(n);
+                    written += static_cast<uint64_t>(n);
+                }
+#endif
+                return true;
+            }
+
+            void finish() {
+#ifdef _WIN32
+                out.close();
+                bool ok = !out.fail();
+#else
+                // Un corpo più corto del previsto non deve lasciare zeri in coda
+                bool ok = (written >= reserved || ftruncate(fd, static_cast<off_t>(written)) == 0);
+                ok = ::close(fd) == 0 && ok;
+#endif
+                finished = true;
+                if (!ok) {
+                    std::remove(path.c_str());
+                    throw std::runtime_error("Could not finalize downloaded file: " + path);
+                }
+            }
+
+        private:
+            std::string path;
+#ifdef _WIN32
+            std::ofstream out;
+#else
+            int fd = -1;
+            uint64_t written = 0;
+            uint64_t reserved = 0;
+#endif
+            bool finished = false;
+        };
+    }
+
+/**
+ * @struct SimpleMinioClient::GetRace
+ * @brief Stato condiviso tra una GET e la sua copia: vince la prima che riceve gli header
+ *
+ * La vincitrice interrompe l'altra richiesta (httplib::Client::stop è pensato
+ * per essere chiamato da un altro thread) e solo lei scrive nella destinazione.
+ */
+    struct SimpleMinioClient::GetRace {
+        std::mutex mutex;
+        std::condition_variable changed;
+        int winner = -1;
+        bool finished[2] = {false, false};
+        httplib::Client* clients[2] = {nullptr, nullptr};
+        std::exception_ptr errors[2];
+
+        // Registra la connessione del tentativo; false se l'altro ha già vinto
+        bool enter(int attempt, httplib::Client* client) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (winner != -1) return false;
+            clients[attempt] = client;
+            return true;
+        }
+
+        void leave(int attempt) {
+            std::lock_guard<std::mutex> lock(mutex);
+            clients[attempt] = nullptr;
+        }
+
+        // true se attempt è (o diventa) la vincitrice
+        bool claim(int attempt) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (winner == -1) {
+                winner = attempt;
+                if (clients[1 - attempt]) clients[1 - attempt]->stop();
+                changed.notify_all();
+            }
+            return winner == attempt;
+        }
 
-        // Ottieni endpoint e credenziali
-        endpoint = env.getMinioEndpoint();
-        accessKey = env.getMinioAccessKey();
-        secretKey = env.getMinioSecretKey();
+        bool lostTo(int attempt) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return winner != -1 && winner != attempt;
+        }
 
+        void finish(int attempt, std::exception_ptr error) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished[attempt] = true;
+            errors[attempt] = error;
+            changed.notify_all();
+        }
+    };
+
+    SimpleMinioClient::SimpleMinioClient(const std::string& endpoint,
+                                         const std::string& accessKey,
+                                         const std::string& secretKey,
+                                         const MinioClientSettings& settings)
+            : endpoint(normalizeEndpoint(endpoint)),
+              accessKey(accessKey),
+              secretKey(secretKey),
+              settings(settings),
+              hostHeader(stripScheme(this->endpoint)),
+              signer(accessKey, secretKey),
+              pool(endpointHost(this->endpoint), endpointPort(this->endpoint), settings.pool_size,
+                   std::chrono::seconds(settings.pool_idle_seconds),
+                   std::chrono::seconds(settings.timeout_seconds)),
+              retry(settings.retry_count, std::chrono::milliseconds(settings.retry_base_ms),
+                    std::chrono::milliseconds(settings.retry_max_ms)),
+              latency(settings.hedge_percentile) {
         // Log per info
-        Logger::info("Initializing SimpleMinioClient with endpoint: " + endpoint);
+        Logger::info("Initializing SimpleMinioClient with endpoint: " + this->endpoint);
         Logger::info("Access Key length: " + std::to_string(accessKey.length()));
         Logger::info("Secret Key length: " + std::to_string(secretKey.length()));
+        Logger::info("Connection pool: " + std::to_string(settings.pool_size) + " connections, idle timeout " +
+                     std::to_string(settings.pool_idle_seconds) + "s");
+        Logger::info("Retries: " + std::to_string(settings.retry_count) + ", timeout " +
+                     std::to_string(settings.timeout_seconds) + "s, hedged GET percentile " +
+                     std::to_string(settings.hedge_percentile));
+    }
+
+    SimpleMinioClient& SimpleMinioClient::instance() {
+        auto& env = EnvironmentHandler::instance();
+        static SimpleMinioClient client(env.getMinioEndpoint(), env.getMinioAccessKey(),
+                                        env.getMinioSecretKey(), env.getMinioClientSettings());
+        return client;
+    }
+
+    std::string SimpleMinioClient::normalizeEndpoint(const std::string& rawEndpoint) {
+        std::string endpoint = rawEndpoint;
 
         // Controlla se l'endpoint include già il protocollo
         if (endpoint.find("http://") != 0 && endpoint.find("https://") != 0) {
@@ -49,7 +293,19 @@ namespace stl2glb {
             Logger::info("Fixed https://http:// in endpoint: " + endpoint);
         }
 
-        initialized = true;
+        return endpoint;
+    }
+
+    // Host e porta dell'endpoint, ricavati una sola volta alla costruzione del pool
+    std::string SimpleMinioClient::endpointHost(const std::string& endpoint) {
+        std::string host = stripScheme(endpoint);
+        return host.substr(0, host.find(":"));
+    }
+
+    int SimpleMinioClient::endpointPort(const std::string& endpoint) {
+        std::string host = stripScheme(endpoint);
+        size_t colonPos = host.find(":");
+        return colonPos == std::string::npos ? 80 : std::stoi(host.substr(colonPos + 1));
     }
 
     // Funzione helper per URL encoding
@@ -76,163 +332,20 @@ namespace stl2glb {
         return escaped.str();
     }
 
-    // Versione moderna di SHA256 usando EVP
     std::string SimpleMinioClient::sha256(const std::string& data) {
-        EVP_MD_CTX* ctx = EVP_MD_CTX_new();
-        if (!ctx) {
-            throw std::runtime_error("Failed to create hash context");
-        }
-
-        std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctxPtr(ctx, EVP_MD_CTX_free);
-
-        if (EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr) != 1) {
-            throw std::runtime_error("Failed to initialize SHA256");
-        }
-
-        if (EVP_DigestUpdate(ctx, data.c_str(), data.size()) != 1) {
-            throw std::runtime_error("Failed to update SHA256");
-        }
-
-        unsigned char hash[EVP_MAX_MD_SIZE];
-        unsigned int hashLen;
-        if (EVP_DigestFinal_ex(ctx, hash, &hashLen) != 1) {
-            throw std::runtime_error("Failed to finalize SHA256");
-        }
-
-        std::stringstream ss;
-        for(unsigned int i = 0; i < hashLen; i++) {
-            ss << std::hex << std::setw(2) << std::setfill('0') << (int)hash[i];
-        }
-        return ss.str();
-    }
-
-    // Versione moderna di HMAC usando EVP
-    std::string SimpleMinioClient::hmacSha256(const std::string& key, const std::string& data) {
-        EVP_MAC* mac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
-        if (!mac) {
-            throw std::runtime_error("Failed to fetch HMAC");
-        }
-
-        std::unique_ptr<EVP_MAC, decltype(&EVP_MAC_free)> macPtr(mac, EVP_MAC_free);
-
-        EVP_MAC_CTX* ctx = EVP_MAC_CTX_new(mac);
-        if (!ctx) {
-            throw std::runtime_error("Failed to create HMAC context");
-        }
-
-        std::unique_ptr<EVP_MAC_CTX, decltype(&EVP_MAC_CTX_free)> ctxPtr(ctx, EVP_MAC_CTX_free);
-
-        OSSL_PARAM params[] = {
-                OSSL_PARAM_construct_utf8_string("digest", const_cast<char*>("SHA256"), 0),
-                OSSL_PARAM_construct_end()
-        };
-
-        if (EVP_MAC_init(ctx, reinterpret_cast<const unsigned char*>(key.c_str()), key.length(), params) != 1) {
-            throw std::runtime_error("Failed to initialize HMAC");
-        }
-
-        if (EVP_MAC_update(ctx, reinterpret_cast<const unsigned char*>(data.c_str()), data.length()) != 1) {
-            throw std::runtime_error("Failed to update HMAC");
-        }
-
-        unsigned char hash[EVP_MAX_MD_SIZE];
-        size_t hashLen;
-        if (EVP_MAC_final(ctx, hash, &hashLen, sizeof(hash)) != 1) {
-            throw std::runtime_error("Failed to finalize HMAC");
-        }
-
-        std::stringstream ss;
-        for(size_t i = 0; i < hashLen; i++) {
-            ss << std::hex << std::setw(2) << std::setfill('0') << (int)hash[i];
-        }
-        return ss.str();
-    }
-
-    std::vector<unsigned char> SimpleMinioClient::hmacSha256Raw(const std::string& key, const std::string& data) {
-        EVP_MAC* mac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
-        if (!mac) {
-            throw std::runtime_error("Failed to fetch HMAC");
-        }
-
-        std::unique_ptr<EVP_MAC, decltype(&EVP_MAC_free)> macPtr(mac, EVP_MAC_free);
-
-        EVP_MAC_CTX* ctx = EVP_MAC_CTX_new(mac);
-        if (!ctx) {
-            throw std::runtime_error("Failed to create HMAC context");
-        }
-
-        std::unique_ptr<EVP_MAC_CTX, decltype(&EVP_MAC_CTX_free)> ctxPtr(ctx, EVP_MAC_CTX_free);
-
-        OSSL_PARAM params[] = {
-                OSSL_PARAM_construct_utf8_string("digest", const_cast<char*>("SHA256"), 0),
-                OSSL_PARAM_construct_end()
-        };
-
-        if (EVP_MAC_init(ctx, reinterpret_cast<const unsigned char*>(key.c_str()), key.length(), params) != 1) {
-            throw std::runtime_error("Failed to initialize HMAC");
-        }
-
-        if (EVP_MAC_update(ctx, reinterpret_cast<const unsigned char*>(data.c_str()), data.length()) != 1) {
-            throw std::runtime_error("Failed to update HMAC");
-        }
-
-        std::vector<unsigned char> hash(EVP_MAX_MD_SIZE);
-        size_t hashLen;
-        if (EVP_MAC_final(ctx, hash.data(), &hashLen, hash.size()) != 1) {
-            throw std::runtime_error("Failed to finalize HMAC");
-        }
-
-        hash.resize(hashLen);
-        return hash;
-    }
-
-    std::string SimpleMinioClient::getAmzDate() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        std::tm* tm = std::gmtime(&time_t);
-
-        char buffer[17];
-        std::strftime(buffer, sizeof(buffer), "%Y%m%dT%H%M%SZ", tm);
-        return std::string(buffer);
-    }
-
-    std::string SimpleMinioClient::getDateStamp() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        std::tm* tm = std::gmtime(&time_t);
-
-        char buffer[9];
-        std::strftime(buffer, sizeof(buffer), "%Y%m%d", tm);
-        return std::string(buffer);
+        return Hasher::sha256(data.data(), data.size());
     }
 
     httplib::Headers SimpleMinioClient::createAwsV4Headers(
             const std::string& method,
             const std::string& path,
             const std::string& payload,
-            const std::string& contentType) {
-
-        // Estrai host completo dall'endpoint (inclusa la porta per MinIO)
-        std::string fullHost = endpoint;
-        if (fullHost.find("http://") == 0) {
-            fullHost = fullHost.substr(7);
-        } else if (fullHost.find("https://") == 0) {
-            fullHost = fullHost.substr(8);
-        }
-
+            const std::string& contentType,
+            const std::string& knownPayloadHash,
+            const std::string& canonicalQuery) const {
         httplib::Headers headers;
 
-        // AWS V4 richiede questi headers
-        std::string amzDate = getAmzDate();
-        std::string dateStamp = getDateStamp();
-        std::string payloadHash = sha256(payload);
-
-        // IMPORTANTE: Per MinIO, usa l'host completo con porta
-        headers.emplace("Host", fullHost);
-        headers.emplace("x-amz-date", amzDate);
-        headers.emplace("x-amz-content-sha256", payloadHash);
         headers.emplace("User-Agent", "SimpleMinioClient/1.0");
-
         if (!contentType.empty()) {
             headers.emplace("Content-Type", contentType);
         }
@@ -240,68 +353,17 @@ namespace stl2glb {
             headers.emplace("Content-Length", std::to_string(payload.size()));
         }
 
-        // URL encode del path per la canonical request
-        // Mantieni il path così com'è per MinIO (non fare l'encode degli slash)
-        std::string canonicalUri = path;
-
-        // Crea la canonical request usando l'host completo con porta
-        std::string canonicalHeaders = "host:" + fullHost + "\n" +
-                                       "x-amz-content-sha256:" + payloadHash + "\n" +
-                                       "x-amz-date:" + amzDate + "\n";
-
-        std::string signedHeaders = "host;x-amz-content-sha256;x-amz-date";
-
-        std::string canonicalRequest = method + "\n" +
-                                       canonicalUri + "\n" +
-                                       "\n" +  // query string vuoto
-                                       canonicalHeaders + "\n" +
-                                       signedHeaders + "\n" +
-                                       payloadHash;
-
-        // Log per info (commentare in produzione)
-        Logger::info("Canonical Request:\n" + canonicalRequest);
-
-        // Crea la string to sign
-        std::string algorithm = "AWS4-HMAC-SHA256";
-        std::string credentialScope = dateStamp + "/us-east-1/s3/aws4_request";
-        std::string hashedCanonicalRequest = sha256(canonicalRequest);
-
-        std::string stringToSign = algorithm + "\n" +
-                                   amzDate + "\n" +
-                                   credentialScope + "\n" +
-                                   hashedCanonicalRequest;
-
-        Logger::info("String to Sign:\n" + stringToSign);
-
-        // Calcola la signing key
-        std::string kSecret = "AWS4" + secretKey;
-        auto kDate = hmacSha256Raw(kSecret, dateStamp);
-        auto kRegion = hmacSha256Raw(std::string(kDate.begin(), kDate.end()), "us-east-1");
-        auto kService = hmacSha256Raw(std::string(kRegion.begin(), kRegion.end()), "s3");
-        auto kSigning = hmacSha256Raw(std::string(kService.begin(), kService.end()), "aws4_request");
-
-        // Calcola la signature
-        std::string signature = hmacSha256(std::string(kSigning.begin(), kSigning.end()), stringToSign);
-
-        Logger::info("Signature: " + signature);
-
-        // Crea l'authorization header
-        std::string authorizationHeader = algorithm + " " +
-                                          "Credential=" + accessKey + "/" + credentialScope + ", " +
-                                          "SignedHeaders=" + signedHeaders + ", " +
-                                          "Signature=" + signature;
-
-        headers.emplace("Authorization", authorizationHeader);
+        // Mantieni il path così com'è per MinIO (non fare l'encode degli slash);
+        // per MinIO l'header Host include la porta
+        std::string payloadHash = knownPayloadHash.empty() ? sha256(payload) : knownPayloadHash;
+        signer.sign(headers, method, hostHeader, path, canonicalQuery, payloadHash);
 
         return headers;
     }
 
-    // Le altre funzioni rimangono identiche...
     void SimpleMinioClient::download(const std::string& bucket,
                                      const std::string& objectName,
                                      const std::string& localPath) {
-        initialize();
-
         try {
             ensureDirectoryExists(localPath);
 
@@ -313,81 +375,279 @@ namespace stl2glb {
                 throw std::runtime_error("Invalid bucket name format");
             }
 
-            // Estrai host e porta dall'endpoint
-            std::string host = endpoint;
-            if (host.find("http://") == 0) {
-                host = host.substr(7);
-            } else if (host.find("https://") == 0) {
-                host = host.substr(8);
-            }
+            // Prepara la richiesta con AWS V4 signature
+            std::string path = "/" + bucket + "/" + objectName;
+            Logger::info("Request path: " + path);
 
-            // Estrai la porta se presente
-            std::string port = "80";
-            size_t colonPos = host.find(":");
-            if (colonPos != std::string::npos) {
-                port = host.substr(colonPos + 1);
-                host = host.substr(0, colonPos);
+            DownloadFile file(localPath);
+#ifndef _WIN32
+            // Oggetti grandi: intervalli scaricati in parallelo e scritti al loro offset
+            uint64_t size = 0;
+            if (parallelDownloadSize(path, size)) {
+                file.setSize(size);
+                getRanges(path, size, [&](uint64_t offset, const char* data, size_t length) {
+                    return file.writeAt(offset, data, length);
+                });
+                file.finish();
+                Logger::info("Download successful: " + objectName);
+                return;
             }
+#endif
 
-            Logger::info("Connecting to " + host + ":" + port);
+            // Ogni blocco ricevuto va direttamente nel file, preallocato da Content-Length
+            getStreaming(path, {},
+                         [&](uint64_t contentLength) {
+                             file.rewind();
+                             file.preallocate(contentLength);
+                         },
+                         [&](const char* data, size_t length) { return file.write(data, length); });
+            file.finish();
 
-            // Crea il client HTTP
-            httplib::Client cli(host, std::stoi(port));
-            cli.set_connection_timeout(30);
-            cli.set_read_timeout(30);
-
-            // Prepara la richiesta con AWS V4 signature
-            std::string path = "/" + bucket + "/" + objectName;
-            Logger::info("Request path: " + path);
+            Logger::info("Download successful: " + objectName);
+        } catch (const std::exception& e) {
+            Logger::error("Exception in download: " + std::string(e.what()));
+            throw;
+        }
+    }
 
-            auto headers = createAwsV4Headers("GET", path, "", "");
+    void SimpleMinioClient::downloadToBuffer(const std::string& bucket,
+                                             const std::string& objectName,
+                                             AlignedBuffer<char>& buffer) {
+        try {
+            Logger::info("Downloading object: " + objectName + " from bucket: " + bucket + " into memory");
 
-            // Log headers per info
-            for (const auto& header : headers) {
-                Logger::info("Header: " + header.first + " = " + header.second);
+            std::string path = "/" + bucket + "/" + objectName;
+            buffer.clear();
+
+            // Oggetti grandi: intervalli scaricati in parallelo e copiati al loro offset
+            uint64_t size = 0;
+            if (parallelDownloadSize(path, size)) {
+                buffer.resize(static_cast<size_t>(size));
+                getRanges(path, size, [&](uint64_t offset, const char* data, size_t length) {
+                    std::memcpy(buffer.data() + offset, data, length);
+                    return true;
+                });
+                Logger::info("Download successful: " + objectName + " (" + std::to_string(size) + " bytes)");
+                return;
             }
 
-            // Esegui la richiesta
-            auto res = cli.Get(path.c_str(), headers);
+            // Buffer dimensionato una sola volta da Content-Length; i blocchi vi vengono accodati
+            getStreaming(path, {},
+                         [&](uint64_t contentLength) {
+                             buffer.clear();
+                             buffer.reserve(static_cast<size_t>(contentLength));
+                         },
+                         [&](const char* data, size_t length) { buffer.append(data, length); return true; });
 
-            if (!res) {
-                Logger::error("HTTP connection error");
-                throw std::runtime_error("HTTP connection error");
-            }
+            Logger::info("Download successful: " + objectName + " (" + std::to_string(buffer.size()) + " bytes)");
+        } catch (const std::exception& e) {
+            Logger::error("Exception in download: " + std::string(e.what()));
+            throw;
+        }
+    }
 
-            if (res->status != 200) {
-                Logger::error("Download failed with status: " + std::to_string(res->status));
-                Logger::error("Response: " + res->body);
+    void SimpleMinioClient::getStreaming(const std::string& path,
+                                         const httplib::Headers& extraHeaders,
+                                         const std::function<void(uint64_t)>& onStart,
+                                         const httplib::ContentReceiver& onData,
+                                         int expectedStatus) {
+        // onStart azzera la destinazione a ogni tentativo: ripetere dopo un corpo
+        // interrotto a metà è sicuro
+        retry.run("GET " + path, [&] {
+            hedgedGet(path, extraHeaders, onStart, onData, expectedStatus);
+        });
+    }
+
+    void SimpleMinioClient::hedgedGet(const std::string& path,
+                                      const httplib::Headers& extraHeaders,
+                                      const std::function<void(uint64_t)>& onStart,
+                                      const httplib::ContentReceiver& onData,
+                                      int expectedStatus) {
+        GetRace race;
+        auto delay = latency.hedgeDelay();
+        if (!delay) {
+            getAttempt(race, 0, path, extraHeaders, onStart, onData, expectedStatus);
+            if (race.errors[0]) std::rethrow_exception(race.errors[0]);
+            return;
+        }
 
-                // Log response headers per info
-                for (const auto& header : res->headers) {
-                    Logger::info("Response Header: " + header.first + " = " + header.second);
+        // La copia parte solo se l'originale non ha ancora ricevuto gli header
+        // (né è fallito) entro il percentile dei tempi di risposta recenti
+        std::thread hedge([&] {
+            {
+                std::unique_lock<std::mutex> lock(race.mutex);
+                if (race.changed.wait_for(lock, *delay, [&] { return race.winner != -1 || race.finished[0]; })) {
+                    return;
                 }
+            }
+            latency.hedgeSent();
+            getAttempt(race, 1, path, extraHeaders, onStart, onData, expectedStatus);
+        });
+        getAttempt(race, 0, path, extraHeaders, onStart, onData, expectedStatus);
+        hedge.join();
+
+        if (race.winner == 1) {
+            latency.hedgeWon();
+        }
+        // Senza vincitrice nessuna delle due ha ricevuto una risposta: vale l'errore dell'originale
+        int outcome = race.winner == -1 ? 0 : race.winner;
+        if (race.errors[outcome]) std::rethrow_exception(race.errors[outcome]);
+    }
+
+    void SimpleMinioClient::getAttempt(GetRace& race,
+                                       int attempt,
+                                       const std::string& path,
+                                       const httplib::Headers& extraHeaders,
+                                       const std::function<void(uint64_t)>& onStart,
+                                       const httplib::ContentReceiver& onData,
+                                       int expectedStatus) {
+        try {
+            auto headers = createAwsV4Headers("GET", path, "", "");
+            headers.insert(extraHeaders.begin(), extraHeaders.end());
 
-                throw std::runtime_error("Download failed with status: " + std::to_string(res->status));
+            auto cli = pool.acquire();
+            if (!race.enter(attempt, &*cli)) {
+                race.finish(attempt, nullptr);
+                return;
             }
 
-            // Scrivi il file su disco
-            std::ofstream outFile(localPath, std::ios::binary);
-            if (!outFile) {
-                throw std::runtime_error("Could not open file for writing: " + localPath);
+            int status = 0;
+            std::string errorBody;
+            bool sinkFailed = false;
+            bool lost = false;
+            auto start = std::chrono::steady_clock::now();
+
+            auto res = cli->Get(path.c_str(), headers,
+                                [&](const httplib::Response& response) {
+                                    // La prima risposta vince; l'altra richiesta si ritira
+                                    if (!race.claim(attempt)) {
+                                        lost = true;
+                                        return false;
+                                    }
+                                    latency.record(std::chrono::duration_cast<std::chrono::microseconds>(
+                                            std::chrono::steady_clock::now() - start));
+
+                                    status = response.status;
+                                    if (status != expectedStatus) {
+                                        for (const auto& header : response.headers) {
+                                            Logger::info("Response Header: " + header.first + " = " + header.second);
+                                        }
+                                        return true;
+                                    }
+                                    uint64_t contentLength = 0;
+                                    if (response.has_header("Content-Length")) {
+                                        std::string value = response.get_header_value("Content-Length");
+                                        contentLength = std::strtoull(value.c_str(), nullptr, 10);
+                                    }
+                                    onStart(contentLength);
+                                    return true;
+                                },
+                                [&](const char* data, size_t length) {
+                                    // Il corpo di una risposta di errore è un breve XML S3
+                                    if (status != expectedStatus) {
+                                        errorBody.append(data, std::min(length, MAX_ERROR_BODY - errorBody.size()));
+                                        return true;
+                                    }
+                                    if (!onData(data, length)) {
+                                        sinkFailed = true;
+                                        return false;
+                                    }
+                                    return true;
+                                });
+            race.leave(attempt);
+
+            if (lost || sinkFailed || !res) {
+                // Risposta interrotta a metà: la connessione non è riutilizzabile
+                cli.discard();
+            }
+            if (lost || (!res && race.lostTo(attempt))) {
+                race.finish(attempt, nullptr);
+                return;
+            }
+            if (sinkFailed) {
+                throw std::runtime_error("Could not store downloaded data for " + path);
+            }
+            if (!res) {
+                Logger::error("HTTP connection error: " + httplib::to_string(res.error()));
+                throw RetryableError("HTTP connection error");
             }
+            if (status != expectedStatus) {
+                Logger::error("Download failed with status: " + std::to_string(status));
+                Logger::error("Response: " + errorBody);
+                RetryPolicy::throwForStatus("Download failed with status", status);
+            }
+            race.finish(attempt, nullptr);
+        } catch (...) {
+            race.finish(attempt, std::current_exception());
+        }
+    }
 
-            outFile.write(res->body.c_str(), res->body.size());
-            outFile.close();
+    bool SimpleMinioClient::parallelDownloadSize(const std::string& path, uint64_t& size) {
+        if (settings.download_concurrency <= 1 || settings.download_part_bytes == 0) {
+            return false;
+        }
 
-            Logger::info("Download successful: " + objectName);
+        // HEAD per la dimensione; qualsiasi errore ricade sul download a stream singolo
+        try {
+            if (headObject(path, &size) != 200) {
+                return false;
+            }
         } catch (const std::exception& e) {
-            Logger::error("Exception in download: " + std::string(e.what()));
-            throw;
+            Logger::warn("Size lookup failed for " + path + ": " + std::string(e.what()));
+            return false;
         }
+
+        return size >= settings.parallel_download_min_bytes && size > settings.download_part_bytes;
+    }
+
+    void SimpleMinioClient::getRanges(const std::string& path, uint64_t size, const RangeSink& sink) {
+        const uint64_t partSize = settings.download_part_bytes;
+        const uint64_t parts = (size + partSize - 1) / partSize;
+        const size_t workers = static_cast<size_t>(
+                std::min<uint64_t>(settings.download_concurrency, parts));
+
+        Logger::info("Parallel download of " + path + ": " + std::to_string(size) + " bytes in " +
+                     std::to_string(parts) + " parts, " + std::to_string(workers) + " connections");
+
+        // Ogni worker prende la parte successiva finché ce ne sono (le connessioni
+        // vengono dal pool a ogni richiesta); al primo errore gli altri smettono di prenderne
+        std::atomic<uint64_t> nextPart{0};
+        std::atomic<bool> failed{false};
+
+        Parallel::run(workers, [&](size_t) {
+            try {
+                for (uint64_t part = nextPart++; part < parts && !failed; part = nextPart++) {
+                    const uint64_t first = part * partSize;
+                    const uint64_t last = std::min(size, first + partSize) - 1;
+
+                    // Range non è tra gli header firmati; ogni tentativo riparte da first
+                    httplib::Headers range{{"Range", "bytes=" + std::to_string(first) + "-" + std::to_string(last)}};
+                    uint64_t offset = first;
+                    getStreaming(path, range, [&](uint64_t) { offset = first; },
+                                 [&](const char* data, size_t length) {
+                                     if (offset + length > last + 1) return false;
+                                     if (!sink(offset, data, length)) return false;
+                                     offset += length;
+                                     return true;
+                                 },
+                                 206);
+
+                    if (offset != last + 1) {
+                        throw std::runtime_error("Incomplete range " + std::to_string(first) + "-" +
+                                                 std::to_string(last) + " for " + path);
+                    }
+                }
+            } catch (...) {
+                failed = true;
+                throw;
+            }
+        });
     }
 
     void SimpleMinioClient::upload(const std::string& bucket,
                                    const std::string& objectName,
-                                   const std::string& localPath) {
-        initialize();
-
+                                   const std::string& localPath,
+                                   const std::string& payloadSha256) {
         try {
             if (!std::filesystem::exists(localPath)) {
                 std::string error = "File not found for upload: " + localPath;
@@ -400,95 +660,381 @@ namespace stl2glb {
             Logger::info("Uploading file of size " + std::to_string(fileSize) +
                          " bytes to " + bucket + "/" + objectName);
 
-            // Leggi il file
+            std::string path = "/" + bucket + "/" + objectName;
+            std::string contentType = "model/gltf-binary";
+
+            // File grandi: parti inviate in parallelo, ognuna ritentata da sola
+            if (fileSize >= settings.multipart_min_bytes && settings.upload_concurrency > 1) {
+                multipartUpload(path, localPath, fileSize, contentType);
+                Logger::info("Upload successful: " + objectName);
+                return;
+            }
+
             std::ifstream inFile(localPath, std::ios::binary);
             if (!inFile) {
                 throw std::runtime_error("Could not open file for reading: " + localPath);
             }
 
-            std::ostringstream ss;
-            ss << inFile.rdbuf();
-            std::string fileContent = ss.str();
+            // Prepara la richiesta con AWS V4 signature. Senza un hash già noto il corpo
+            // non viene firmato, per non dover leggere il file due volte
+            std::string payloadHash = payloadSha256.empty() ? UNSIGNED_PAYLOAD : payloadSha256;
+
+            // Il file viene inviato a blocchi da un buffer fisso: memoria costante
+            // qualunque sia la dimensione dell'oggetto
+            std::vector<char> buffer(UPLOAD_BLOCK_SIZE);
+            size_t position = 0;
+            httplib::ContentProvider provider = [&](size_t offset, size_t length, httplib::DataSink& sink) {
+                if (offset != position) {
+                    inFile.clear();
+                    inFile.seekg(static_cast<std::streamoff>(offset));
+                    position = offset;
+                }
+
+                size_t chunk = std::min(length, buffer.size());
+                if (!inFile.read(buffer.data(), static_cast<std::streamsize>(chunk))) {
+                    Logger::error("Could not read file for upload: " + localPath);
+                    return false;
+                }
+                position += chunk;
+                return sink.write(buffer.data(), chunk);
+            };
+
+            // Esegui la richiesta su una connessione del pool; un nuovo tentativo
+            // rilegge il file dall'inizio (il provider riposiziona lo stream)
+            retry.run("PUT " + path, [&] {
+                auto headers = createAwsV4Headers("PUT", path, "", contentType, payloadHash);
+
+                auto cli = pool.acquire();
+                auto res = cli->Put(path.c_str(), headers, static_cast<size_t>(fileSize), provider, contentType);
+
+                if (!res) {
+                    cli.discard();
+                    Logger::error("HTTP connection error");
+                    throw RetryableError("HTTP connection error");
+                }
 
-            // Estrai host e porta dall'endpoint
-            std::string host = endpoint;
-            if (host.find("http://") == 0) {
-                host = host.substr(7);
-            } else if (host.find("https://") == 0) {
-                host = host.substr(8);
+                if (res->status != 200 && res->status != 204) {
+                    Logger::error("Upload failed with status: " + std::to_string(res->status));
+                    Logger::error("Response: " + res->body);
+                    RetryPolicy::throwForStatus("Upload failed with status", res->status);
+                }
+            });
+
+            Logger::info("Upload successful: " + objectName);
+        } catch (const std::exception& e) {
+            Logger::error("Exception in upload: " + std::string(e.what()));
+            throw;
+        }
+    }
+
+    void SimpleMinioClient::multipartUpload(const std::string& path,
+                                            const std::string& localPath,
+                                            uint64_t fileSize,
+                                            const std::string& contentType) {
+        // S3 accetta al massimo MAX_MULTIPART_PARTS parti: oltre, le parti crescono
+        uint64_t partSize = std::max<uint64_t>(settings.multipart_part_bytes, MIN_MULTIPART_PART_SIZE);
+        partSize = std::max<uint64_t>(partSize, (fileSize + MAX_MULTIPART_PARTS - 1) / MAX_MULTIPART_PARTS);
+        const uint64_t parts = (fileSize + partSize - 1) / partSize;
+        const size_t workers = static_cast<size_t>(std::min<uint64_t>(settings.upload_concurrency, parts));
+
+        std::string uploadId = initiateMultipart(path, contentType);
+        Logger::info("Multipart upload of " + path + ": " + std::to_string(parts) + " parts of " +
+                     std::to_string(partSize) + " bytes, " + std::to_string(workers) + " connections");
+
+        std::vector<std::string> etags(parts);
+        std::atomic<uint64_t> nextPart{0};
+        std::atomic<bool> failed{false};
+
+        try {
+            Parallel::run(workers, [&](size_t) {
+                // Un file aperto e un buffer per worker; le parti sono lette a offset disgiunti
+                std::ifstream in(localPath, std::ios::binary);
+                if (!in) {
+                    throw std::runtime_error("Could not open file for reading: " + localPath);
+                }
+                std::vector<char> buffer(UPLOAD_BLOCK_SIZE);
+
+                try {
+                    for (uint64_t part = nextPart++; part < parts && !failed; part = nextPart++) {
+                        uint64_t offset = part * partSize;
+                        uint64_t length = std::min(partSize, fileSize - offset);
+                        etags[part] = uploadPart(path, uploadId, static_cast<unsigned int>(part + 1),
+                                                 in, offset, length, buffer);
+                    }
+                } catch (...) {
+                    failed = true;
+                    throw;
+                }
+            });
+
+            completeMultipart(path, uploadId, etags);
+        } catch (const std::exception& e) {
+            // Senza abort le parti già caricate restano occupate nel bucket
+            Logger::error("Multipart upload failed for " + path + ": " + e.what());
+            abortMultipart(path, uploadId);
+            throw;
+        }
+    }
+
+    std::string SimpleMinioClient::initiateMultipart(const std::string& path, const std::string& contentType) {
+        const std::string query = "uploads=";
+        return retry.run("POST " + path + "?uploads", [&] {
+            auto headers = createAwsV4Headers("POST", path, "", contentType, "", query);
+
+            auto cli = pool.acquire();
+            auto res = cli->Post((path + "?" + query).c_str(), headers, "", contentType);
+            if (!res) {
+                cli.discard();
+                throw RetryableError("HTTP connection error");
+            }
+            if (res->status != 200) {
+                Logger::error("Response: " + res->body);
+                RetryPolicy::throwForStatus("Initiate multipart upload failed with status", res->status);
             }
 
-            // Estrai la porta se presente
-            std::string port = "80";
-            size_t colonPos = host.find(":");
-            if (colonPos != std::string::npos) {
-                port = host.substr(colonPos + 1);
-                host = host.substr(0, colonPos);
+            std::string uploadId = xmlValue(res->body, "UploadId");
+            if (uploadId.empty()) {
+                throw std::runtime_error("Missing UploadId in multipart upload response");
             }
+            return uploadId;
+        });
+    }
 
-            // Crea il client HTTP
-            httplib::Client cli(host, std::stoi(port));
-            cli.set_connection_timeout(30);
-            cli.set_read_timeout(30);
+    std::string SimpleMinioClient::uploadPart(const std::string& path,
+                                              const std::string& uploadId,
+                                              unsigned int partNumber,
+                                              std::ifstream& in,
+                                              uint64_t offset,
+                                              uint64_t length,
+                                              std::vector<char>& buffer) {
+        const std::string query = "partNumber=" + std::to_string(partNumber) +
+                                  "&uploadId=" + urlEncode(uploadId);
+        const std::string target = path + "?" + query;
+
+        httplib::ContentProvider provider = [&](size_t position, size_t remaining, httplib::DataSink& sink) {
+            size_t chunk = std::min(remaining, buffer.size());
+            in.clear();
+            in.seekg(static_cast<std::streamoff>(offset + position));
+            if (!in.read(buffer.data(), static_cast<std::streamsize>(chunk))) {
+                Logger::error("Could not read part " + std::to_string(partNumber) + " for upload");
+                return false;
+            }
+            return sink.write(buffer.data(), chunk);
+        };
 
-            // Prepara la richiesta con AWS V4 signature
-            std::string path = "/" + bucket + "/" + objectName;
-            std::string contentType = "model/gltf-binary";
-            auto headers = createAwsV4Headers("PUT", path, fileContent, contentType);
+        // Una parte fallita per errore di rete o del server viene ritentata da sola
+        return retry.run("PUT " + path + " part " + std::to_string(partNumber), [&] {
+            auto headers = createAwsV4Headers("PUT", path, "", "", UNSIGNED_PAYLOAD, query);
 
-            // Esegui la richiesta
-            auto res = cli.Put(path.c_str(), headers, fileContent, contentType);
+            auto cli = pool.acquire();
+            auto res = cli->Put(target.c_str(), headers, static_cast<size_t>(length), provider,
+                                "application/octet-stream");
 
             if (!res) {
-                Logger::error("HTTP connection error");
-                throw std::runtime_error("HTTP connection error");
+                cli.discard();
+                throw RetryableError("HTTP connection error");
+            }
+            if (res->status != 200) {
+                RetryPolicy::throwForStatus("Upload part " + std::to_string(partNumber) + " failed with status",
+                                            res->status);
             }
 
-            if (res->status != 200 && res->status != 204) {
-                Logger::error("Upload failed with status: " + std::to_string(res->status));
+            std::string etag = res->get_header_value("ETag");
+            if (etag.empty()) {
+                throw std::runtime_error("Missing ETag for part " + std::to_string(partNumber));
+            }
+            return etag;
+        });
+    }
+
+    void SimpleMinioClient::completeMultipart(const std::string& path,
+                                              const std::string& uploadId,
+                                              const std::vector<std::string>& etags) {
+        std::string body = "<CompleteMultipartUpload>";
+        for (size_t i = 0; i < etags.size(); ++i) {
+            body += "<Part><PartNumber>" + std::to_string(i + 1) + "</PartNumber><ETag>" +
+                    etags[i] + "</ETag></Part>";
+        }
+        body += "</CompleteMultipartUpload>";
+
+        const std::string query = "uploadId=" + urlEncode(uploadId);
+        retry.run("POST " + path + "?uploadId", [&] {
+            auto headers = createAwsV4Headers("POST", path, body, "application/xml", "", query);
+
+            auto cli = pool.acquire();
+            auto res = cli->Post((path + "?" + query).c_str(), headers, body, "application/xml");
+            if (!res) {
+                cli.discard();
+                throw RetryableError("HTTP connection error");
+            }
+            if (res->status != 200) {
+                Logger::error("Response: " + res->body);
+                RetryPolicy::throwForStatus("Complete multipart upload failed with status", res->status);
+            }
+            // S3 può rispondere 200 con un <Error> nel corpo: va ripetuta
+            if (res->body.find("<Error>") != std::string::npos) {
                 Logger::error("Response: " + res->body);
-                throw std::runtime_error("Upload failed with status: " + std::to_string(res->status));
+                throw RetryableError("Complete multipart upload failed: " + xmlValue(res->body, "Code"));
             }
+        });
+    }
 
-            Logger::info("Upload successful: " + objectName);
+    void SimpleMinioClient::abortMultipart(const std::string& path, const std::string& uploadId) {
+        try {
+            const std::string query = "uploadId=" + urlEncode(uploadId);
+            retry.run("DELETE " + path + "?uploadId", [&] {
+                auto headers = createAwsV4Headers("DELETE", path, "", "", "", query);
+
+                auto cli = pool.acquire();
+                auto res = cli->Delete((path + "?" + query).c_str(), headers);
+                if (!res) {
+                    cli.discard();
+                    throw RetryableError("HTTP connection error");
+                }
+                if (res->status != 204 && res->status != 200) {
+                    RetryPolicy::throwForStatus("Abort multipart upload failed with status", res->status);
+                }
+            });
         } catch (const std::exception& e) {
-            Logger::error("Exception in upload: " + std::string(e.what()));
-            throw;
+            Logger::warn("Exception in abortMultipart: " + std::string(e.what()));
         }
     }
 
-    bool SimpleMinioClient::ensureBucketExists(const std::string& bucketName) {
+    int SimpleMinioClient::headObject(const std::string& path, uint64_t* size) {
+        return retry.run("HEAD " + path, [&] {
+            auto headers = createAwsV4Headers("HEAD", path, "", "");
+            auto cli = pool.acquire();
+            auto res = cli->Head(path.c_str(), headers);
+            if (!res) {
+                cli.discard();
+                throw RetryableError("HTTP connection error");
+            }
+            if (RetryPolicy::retryableStatus(res->status)) {
+                RetryPolicy::throwForStatus("HEAD failed with status", res->status);
+            }
+            if (size && res->status == 200) {
+                if (!res->has_header("Content-Length")) {
+                    throw std::runtime_error("Missing Content-Length for " + path);
+                }
+                *size = std::strtoull(res->get_header_value("Content-Length").c_str(), nullptr, 10);
+            }
+            return res->status;
+        });
+    }
+
+    void SimpleMinioClient::downloadRange(const std::string& bucket,
+                                          const std::string& objectName,
+                                          uint64_t offset,
+                                          uint64_t length,
+                                          std::string& content) {
+        content.clear();
+        if (length == 0) {
+            return;
+        }
+
+        std::string path = "/" + bucket + "/" + objectName;
+        httplib::Headers range{{"Range", "bytes=" + std::to_string(offset) + "-" +
+                                         std::to_string(offset + length - 1)}};
+        getStreaming(path, range,
+                     [&](uint64_t contentLength) {
+                         content.clear();
+                         content.reserve(static_cast<size_t>(std::min(contentLength, length)));
+                     },
+                     [&](const char* data, size_t size) {
+                         if (content.size() + size > length) return false;
+                         content.append(data, size);
+                         return true;
+                     },
+                     206);
+    }
+
+    bool SimpleMinioClient::objectExists(const std::string& bucket, const std::string& objectName, uint64_t* size) {
         try {
-            Logger::info("Checking if bucket exists: " + bucketName);
+            std::string path = "/" + bucket + "/" + objectName;
+            int status = headObject(path, size);
+            if (status == 200) {
+                return true;
+            }
+            if (status != 404) {
+                Logger::warn("Unexpected status code checking object " + objectName + ": " +
+                             std::to_string(status));
+            }
+            return false;
+        } catch (const std::exception& e) {
+            Logger::warn("Exception in objectExists: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    bool SimpleMinioClient::getText(const std::string& bucket,
+                                    const std::string& objectName,
+                                    std::string& content) {
+        std::string path = "/" + bucket + "/" + objectName;
+        return retry.run("GET " + path, [&] {
+            auto headers = createAwsV4Headers("GET", path, "", "");
+
+            auto cli = pool.acquire();
+            auto res = cli->Get(path.c_str(), headers);
 
-            // Estrai host e porta dall'endpoint
-            std::string host = endpoint;
-            if (host.find("http://") == 0) {
-                host = host.substr(7);
-            } else if (host.find("https://") == 0) {
-                host = host.substr(8);
+            if (!res) {
+                cli.discard();
+                throw RetryableError("HTTP connection error");
+            }
+            if (res->status == 404) {
+                return false;
             }
+            if (res->status != 200) {
+                RetryPolicy::throwForStatus("Get failed with status", res->status);
+            }
+
+            content = res->body;
+            return true;
+        });
+    }
 
-            // Estrai la porta se presente
-            std::string port = "80";
-            size_t colonPos = host.find(":");
-            if (colonPos != std::string::npos) {
-                port = host.substr(colonPos + 1);
-                host = host.substr(0, colonPos);
+    void SimpleMinioClient::putText(const std::string& bucket,
+                                    const std::string& objectName,
+                                    const std::string& content,
+                                    const std::string& contentType) {
+        std::string path = "/" + bucket + "/" + objectName;
+        retry.run("PUT " + path, [&] {
+            auto headers = createAwsV4Headers("PUT", path, content, contentType);
+
+            auto cli = pool.acquire();
+            auto res = cli->Put(path.c_str(), headers, content, contentType);
+
+            if (!res) {
+                cli.discard();
+                throw RetryableError("HTTP connection error");
+            }
+            if (res->status != 200 && res->status != 204) {
+                RetryPolicy::throwForStatus("Put failed with status", res->status);
             }
+        });
+    }
+
+    HedgeStats SimpleMinioClient::hedgeStats() const {
+        return latency.stats();
+    }
+
+    HttpPoolStats SimpleMinioClient::poolStats() const {
+        return pool.stats();
+    }
 
-            // Crea il client HTTP
-            httplib::Client cli(host, std::stoi(port));
-            cli.set_connection_timeout(10);
+    bool SimpleMinioClient::ensureBucketExists(const std::string& bucketName) {
+        try {
+            Logger::info("Checking if bucket exists: " + bucketName);
 
             // Prepara la richiesta con AWS V4 signature
             std::string path = "/" + bucketName;
             auto headers = createAwsV4Headers("HEAD", path, "", "");
 
             // Esegui la richiesta
-            auto res = cli.Head(path.c_str(), headers);
+            auto cli = pool.acquire();
+            auto res = cli->Head(path.c_str(), headers);
 
             if (!res) {
+                cli.discard();
                 Logger::warn("HTTP connection error");
                 return false;
             }
@@ -513,34 +1059,16 @@ namespace stl2glb {
         try {
             Logger::info("Creating bucket: " + bucketName);
 
-            // Estrai host e porta dall'endpoint
-            std::string host = endpoint;
-            if (host.find("http://") == 0) {
-                host = host.substr(7);
-            } else if (host.find("https://") == 0) {
-                host = host.substr(8);
-            }
-
-            // Estrai la porta se presente
-            std::string port = "80";
-            size_t colonPos = host.find(":");
-            if (colonPos != std::string::npos) {
-                port = host.substr(colonPos + 1);
-                host = host.substr(0, colonPos);
-            }
-
-            // Crea il client HTTP
-            httplib::Client cli(host, std::stoi(port));
-            cli.set_connection_timeout(10);
-
             // Prepara la richiesta con AWS V4 signature
             std::string path = "/" + bucketName;
             auto headers = createAwsV4Headers("PUT", path, "", "");
 
             // Esegui la richiesta
-            auto res = cli.Put(path.c_str(), headers, "", "");
+            auto cli = pool.acquire();
+            auto res = cli->Put(path.c_str(), headers, "", "");
 
             if (!res) {
+                cli.discard();
                 Logger::error("HTTP connection error");
                 return false;
             }
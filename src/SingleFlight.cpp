@@ -0,0 +1,47 @@
+#include "stl2glb/SingleFlight.hpp"
+
+namespace stl2glb {
+
+    std::string SingleFlight::run(const std::string& key, const std::function<std::string()>& fn, bool* shared) {
+        std::promise<std::string> promise;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto it = calls.find(key);
+            if (it != calls.end()) {
+                std::shared_future<std::string> pending = it->second;
+                lock.unlock();
+
+                if (shared) *shared = true;
+                return pending.get();
+            }
+            calls.emplace(key, promise.get_future().share());
+        }
+
+        if (shared) *shared = false;
+
+        // La chiave viene rimossa prima di pubblicare il risultato: chi arriva dopo
+        // riesegue fn (e trova i risultati nella cache), chi era già in attesa lo riceve
+        try {
+            std::string result = fn();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                calls.erase(key);
+            }
+            promise.set_value(result);
+            return result;
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                calls.erase(key);
+            }
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    size_t SingleFlight::inFlight() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return calls.size();
+    }
+
+} // namespace stl2glb
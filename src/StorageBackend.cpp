@@ -0,0 +1,31 @@
+#include "stl2glb/StorageBackend.hpp"
+#include "stl2glb/EnvironmentHandler.hpp"
+#include "stl2glb/FileSystemStorageBackend.hpp"
+#include "stl2glb/Logger.hpp"
+#include "stl2glb/MemoryStorageBackend.hpp"
+#include "stl2glb/S3StorageBackend.hpp"
+
+namespace stl2glb {
+
+    std::unique_ptr<StorageBackend> StorageBackend::create(StorageType type, const std::string& root) {
+        switch (type) {
+            case StorageType::FileSystem:
+                return std::make_unique<FileSystemStorageBackend>(root);
+            case StorageType::Memory:
+                return std::make_unique<MemoryStorageBackend>();
+            default:
+                return std::make_unique<S3StorageBackend>();
+        }
+    }
+
+    StorageBackend& StorageBackend::instance() {
+        static std::unique_ptr<StorageBackend> backend = [] {
+            auto& env = EnvironmentHandler::instance();
+            auto created = create(env.getStorageType(), env.getStorageRoot());
+            Logger::info(std::string("Storage backend: ") + created->name());
+            return created;
+        }();
+        return *backend;
+    }
+
+} // namespace stl2glb
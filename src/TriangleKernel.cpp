@@ -0,0 +1,343 @@
+#include "stl2glb/TriangleKernel.hpp"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// I kernel vettoriali usano le estensioni GCC/Clang per il multiversioning;
+// sulle altre piattaforme resta solo il percorso scalare
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STL2GLB_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace stl2glb {
+
+    namespace {
+        constexpr size_t RECORD_SIZE = sizeof(STLTriangleRaw);
+        constexpr float AREA_EPSILON = 1e-6f;
+        constexpr float MIN_NORMAL_LENGTH = 0.1f;
+
+        // Destinazione SoA dei triangoli validi
+        struct Output {
+            float* positions;
+            float* normals;
+            size_t written = 0;
+        };
+
+        // Scrive un triangolo valido: vertici dal record, normale già corretta
+        inline void emitTriangle(const uint8_t* record, float nx, float ny, float nz, Output& out) {
+            std::memcpy(out.positions + out.written * Mesh::FLOATS_PER_TRIANGLE,
+                        record + offsetof(STLTriangleRaw, vertex1), Mesh::FLOATS_PER_TRIANGLE * sizeof(float));
+            if (out.normals) {
+                float* normal = out.normals + out.written * Mesh::FLOATS_PER_NORMAL;
+                normal[0] = nx;
+                normal[1] = ny;
+                normal[2] = nz;
+            }
+            ++out.written;
+        }
+
+        // Percorso scalare: è il riferimento per la compatibilità bit a bit.
+        // Il prodotto vettoriale viene calcolato una sola volta e la sua norma,
+        // già usata per l'area, serve anche per ricalcolare la normale.
+        size_t processScalar(const uint8_t* records, size_t count, Output& out,
+                             std::vector<uint32_t>& rejected, uint32_t firstIndex) {
+            const size_t start = out.written;
+
+            for (size_t i = 0; i < count; ++i) {
+                const uint8_t* record = records + i * RECORD_SIZE;
+                float f[12];
+                std::memcpy(f, record, sizeof(f));
+
+                // Verifica che i vertici non siano NaN o infiniti
+                bool finite = true;
+                for (int k = 3; k < 12; ++k) {
+                    finite = finite && std::isfinite(f[k]);
+                }
+
+                float v1x = f[6] - f[3], v1y = f[7] - f[4], v1z = f[8] - f[5];
+                float v2x = f[9] - f[3], v2y = f[10] - f[4], v2z = f[11] - f[5];
+
+                float cx = v1y * v2z - v1z * v2y;
+                float cy = v1z * v2x - v1x * v2z;
+                float cz = v1x * v2y - v1y * v2x;
+
+                float area = std::sqrt(cx * cx + cy * cy + cz * cz);
+                if (!finite || !(area > AREA_EPSILON)) {
+                    rejected.push_back(firstIndex + static_cast<uint32_t>(i));
+                    continue;
+                }
+
+                float normalLen = std::sqrt(f[0] * f[0] + f[1] * f[1] + f[2] * f[2]);
+                float nx, ny, nz;
+                if (normalLen < MIN_NORMAL_LENGTH || !std::isfinite(normalLen)) {
+                    // Normale dal prodotto vettoriale: la sua lunghezza è l'area,
+                    // sempre > epsilon per un triangolo valido
+                    nx = cx / area;
+                    ny = cy / area;
+                    nz = cz / area;
+                } else {
+                    nx = f[0] / normalLen;
+                    ny = f[1] / normalLen;
+                    nz = f[2] / normalLen;
+                }
+
+                emitTriangle(record, nx, ny, nz, out);
+            }
+
+            return out.written - start;
+        }
+
+#ifdef STL2GLB_KERNEL_X86
+        // Trasposizione AoS -> SoA: lanes[campo][triangolo]
+        template <size_t W>
+        inline void gatherFields(const uint8_t* batch, float (&lanes)[12][W]) {
+            for (size_t j = 0; j < W; ++j) {
+                float f[12];
+                std::memcpy(f, batch + j * RECORD_SIZE, sizeof(f));
+                for (int k = 0; k < 12; ++k) {
+                    lanes[k][j] = f[k];
+                }
+            }
+        }
+
+        // Compatta i triangoli validi del blocco mantenendo l'ordine dei record
+        template <size_t W>
+        inline void emitBatch(const uint8_t* batch, unsigned validMask, const float (&normals)[3][W],
+                              Output& out, std::vector<uint32_t>& rejected, uint32_t baseIndex) {
+            for (size_t j = 0; j < W; ++j) {
+                if (validMask & (1u << j)) {
+                    emitTriangle(batch + j * RECORD_SIZE, normals[0][j], normals[1][j], normals[2][j], out);
+                } else {
+                    rejected.push_back(baseIndex + static_cast<uint32_t>(j));
+                }
+            }
+        }
+
+        __attribute__((target("sse4.2")))
+        size_t processSSE42(const uint8_t* records, size_t count, Output& out,
+                            std::vector<uint32_t>& rejected, uint32_t firstIndex) {
+            constexpr size_t W = 4;
+            alignas(16) float lanes[12][W];
+            alignas(16) float normals[3][W];
+
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+            const __m128 areaEps = _mm_set1_ps(AREA_EPSILON);
+            const __m128 minLen = _mm_set1_ps(MIN_NORMAL_LENGTH);
+
+            const size_t start = out.written;
+            size_t i = 0;
+            for (; i + W <= count; i += W) {
+                const uint8_t* batch = records + i * RECORD_SIZE;
+                gatherFields<W>(batch, lanes);
+
+                // |x| < inf è falso sia per infiniti che per NaN
+                __m128 finite = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (int k = 3; k < 12; ++k) {
+                    __m128 v = _mm_load_ps(lanes[k]);
+                    finite = _mm_and_ps(finite, _mm_cmplt_ps(_mm_and_ps(v, absMask), inf));
+                }
+
+                __m128 x1 = _mm_load_ps(lanes[3]), y1 = _mm_load_ps(lanes[4]), z1 = _mm_load_ps(lanes[5]);
+                __m128 v1x = _mm_sub_ps(_mm_load_ps(lanes[6]), x1);
+                __m128 v1y = _mm_sub_ps(_mm_load_ps(lanes[7]), y1);
+                __m128 v1z = _mm_sub_ps(_mm_load_ps(lanes[8]), z1);
+                __m128 v2x = _mm_sub_ps(_mm_load_ps(lanes[9]), x1);
+                __m128 v2y = _mm_sub_ps(_mm_load_ps(lanes[10]), y1);
+                __m128 v2z = _mm_sub_ps(_mm_load_ps(lanes[11]), z1);
+
+                __m128 cx = _mm_sub_ps(_mm_mul_ps(v1y, v2z), _mm_mul_ps(v1z, v2y));
+                __m128 cy = _mm_sub_ps(_mm_mul_ps(v1z, v2x), _mm_mul_ps(v1x, v2z));
+                __m128 cz = _mm_sub_ps(_mm_mul_ps(v1x, v2y), _mm_mul_ps(v1y, v2x));
+
+                __m128 area = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)),
+                                                     _mm_mul_ps(cz, cz)));
+                __m128 valid = _mm_and_ps(finite, _mm_cmpgt_ps(area, areaEps));
+
+                __m128 nx = _mm_load_ps(lanes[0]), ny = _mm_load_ps(lanes[1]), nz = _mm_load_ps(lanes[2]);
+                __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)),
+                                                    _mm_mul_ps(nz, nz)));
+                __m128 keep = _mm_and_ps(_mm_cmpge_ps(len, minLen), _mm_cmplt_ps(len, inf));
+
+                _mm_store_ps(normals[0], _mm_blendv_ps(_mm_div_ps(cx, area), _mm_div_ps(nx, len), keep));
+                _mm_store_ps(normals[1], _mm_blendv_ps(_mm_div_ps(cy, area), _mm_div_ps(ny, len), keep));
+                _mm_store_ps(normals[2], _mm_blendv_ps(_mm_div_ps(cz, area), _mm_div_ps(nz, len), keep));
+
+                unsigned mask = static_cast<unsigned>(_mm_movemask_ps(valid));
+                emitBatch<W>(batch, mask, normals, out, rejected,
+                                        firstIndex + static_cast<uint32_t>(i));
+            }
+
+            processScalar(records + i * RECORD_SIZE, count - i, out, rejected,
+                          firstIndex + static_cast<uint32_t>(i));
+            return out.written - start;
+        }
+
+        __attribute__((target("avx2")))
+        size_t processAVX2(const uint8_t* records, size_t count, Output& out,
+                           std::vector<uint32_t>& rejected, uint32_t firstIndex) {
+            constexpr size_t W = 8;
+            alignas(32) float lanes[12][W];
+            alignas(32) float normals[3][W];
+
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+            const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+            const __m256 areaEps = _mm256_set1_ps(AREA_EPSILON);
+            const __m256 minLen = _mm256_set1_ps(MIN_NORMAL_LENGTH);
+
+            const size_t start = out.written;
+            size_t i = 0;
+            for (; i + W <= count; i += W) {
+                const uint8_t* batch = records + i * RECORD_SIZE;
+                gatherFields<W>(batch, lanes);
+
+                __m256 finite = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (int k = 3; k < 12; ++k) {
+                    __m256 v = _mm256_load_ps(lanes[k]);
+                    finite = _mm256_and_ps(finite, _mm256_cmp_ps(_mm256_and_ps(v, absMask), inf, _CMP_LT_OQ));
+                }
+
+                __m256 x1 = _mm256_load_ps(lanes[3]), y1 = _mm256_load_ps(lanes[4]), z1 = _mm256_load_ps(lanes[5]);
+                __m256 v1x = _mm256_sub_ps(_mm256_load_ps(lanes[6]), x1);
+                __m256 v1y = _mm256_sub_ps(_mm256_load_ps(lanes[7]), y1);
+                __m256 v1z = _mm256_sub_ps(_mm256_load_ps(lanes[8]), z1);
+                __m256 v2x = _mm256_sub_ps(_mm256_load_ps(lanes[9]), x1);
+                __m256 v2y = _mm256_sub_ps(_mm256_load_ps(lanes[10]), y1);
+                __m256 v2z = _mm256_sub_ps(_mm256_load_ps(lanes[11]), z1);
+
+                __m256 cx = _mm256_sub_ps(_mm256_mul_ps(v1y, v2z), _mm256_mul_ps(v1z, v2y));
+                __m256 cy = _mm256_sub_ps(_mm256_mul_ps(v1z, v2x), _mm256_mul_ps(v1x, v2z));
+                __m256 cz = _mm256_sub_ps(_mm256_mul_ps(v1x, v2y), _mm256_mul_ps(v1y, v2x));
+
+                __m256 area = _mm256_sqrt_ps(_mm256_add_ps(
+                        _mm256_add_ps(_mm256_mul_ps(cx, cx), _mm256_mul_ps(cy, cy)), _mm256_mul_ps(cz, cz)));
+                __m256 valid = _mm256_and_ps(finite, _mm256_cmp_ps(area, areaEps, _CMP_GT_OQ));
+
+                __m256 nx = _mm256_load_ps(lanes[0]), ny = _mm256_load_ps(lanes[1]), nz = _mm256_load_ps(lanes[2]);
+                __m256 len = _mm256_sqrt_ps(_mm256_add_ps(
+                        _mm256_add_ps(_mm256_mul_ps(nx, nx), _mm256_mul_ps(ny, ny)), _mm256_mul_ps(nz, nz)));
+                __m256 keep = _mm256_and_ps(_mm256_cmp_ps(len, minLen, _CMP_GE_OQ),
+                                            _mm256_cmp_ps(len, inf, _CMP_LT_OQ));
+
+                _mm256_store_ps(normals[0], _mm256_blendv_ps(_mm256_div_ps(cx, area), _mm256_div_ps(nx, len), keep));
+                _mm256_store_ps(normals[1], _mm256_blendv_ps(_mm256_div_ps(cy, area), _mm256_div_ps(ny, len), keep));
+                _mm256_store_ps(normals[2], _mm256_blendv_ps(_mm256_div_ps(cz, area), _mm256_div_ps(nz, len), keep));
+
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(valid));
+                emitBatch<W>(batch, mask, normals, out, rejected,
+                                        firstIndex + static_cast<uint32_t>(i));
+            }
+
+            processScalar(records + i * RECORD_SIZE, count - i, out, rejected,
+                          firstIndex + static_cast<uint32_t>(i));
+            return out.written - start;
+        }
+
+        // GCC 12 segnala un falso positivo dentro _mm512_sqrt_ps
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+        __attribute__((target("avx512f")))
+        size_t processAVX512(const uint8_t* records, size_t count, Output& out,
+                             std::vector<uint32_t>& rejected, uint32_t firstIndex) {
+            constexpr size_t W = 16;
+            alignas(64) float lanes[12][W];
+            alignas(64) float normals[3][W];
+
+            const __m512 inf = _mm512_set1_ps(std::numeric_limits<float>::infinity());
+            const __m512 areaEps = _mm512_set1_ps(AREA_EPSILON);
+            const __m512 minLen = _mm512_set1_ps(MIN_NORMAL_LENGTH);
+
+            const size_t start = out.written;
+            size_t i = 0;
+            for (; i + W <= count; i += W) {
+                const uint8_t* batch = records + i * RECORD_SIZE;
+                gatherFields<W>(batch, lanes);
+
+                __mmask16 finite = 0xFFFF;
+                for (int k = 3; k < 12; ++k) {
+                    __m512 v = _mm512_load_ps(lanes[k]);
+                    finite &= _mm512_cmp_ps_mask(_mm512_abs_ps(v), inf, _CMP_LT_OQ);
+                }
+
+                __m512 x1 = _mm512_load_ps(lanes[3]), y1 = _mm512_load_ps(lanes[4]), z1 = _mm512_load_ps(lanes[5]);
+                __m512 v1x = _mm512_sub_ps(_mm512_load_ps(lanes[6]), x1);
+                __m512 v1y = _mm512_sub_ps(_mm512_load_ps(lanes[7]), y1);
+                __m512 v1z = _mm512_sub_ps(_mm512_load_ps(lanes[8]), z1);
+                __m512 v2x = _mm512_sub_ps(_mm512_load_ps(lanes[9]), x1);
+                __m512 v2y = _mm512_sub_ps(_mm512_load_ps(lanes[10]), y1);
+                __m512 v2z = _mm512_sub_ps(_mm512_load_ps(lanes[11]), z1);
+
+                __m512 cx = _mm512_sub_ps(_mm512_mul_ps(v1y, v2z), _mm512_mul_ps(v1z, v2y));
+                __m512 cy = _mm512_sub_ps(_mm512_mul_ps(v1z, v2x), _mm512_mul_ps(v1x, v2z));
+                __m512 cz = _mm512_sub_ps(_mm512_mul_ps(v1x, v2y), _mm512_mul_ps(v1y, v2x));
+
+                __m512 area = _mm512_sqrt_ps(_mm512_add_ps(
+                        _mm512_add_ps(_mm512_mul_ps(cx, cx), _mm512_mul_ps(cy, cy)), _mm512_mul_ps(cz, cz)));
+                __mmask16 valid = finite & _mm512_cmp_ps_mask(area, areaEps, _CMP_GT_OQ);
+
+                __m512 nx = _mm512_load_ps(lanes[0]), ny = _mm512_load_ps(lanes[1]), nz = _mm512_load_ps(lanes[2]);
+                __m512 len = _mm512_sqrt_ps(_mm512_add_ps(
+                        _mm512_add_ps(_mm512_mul_ps(nx, nx), _mm512_mul_ps(ny, ny)), _mm512_mul_ps(nz, nz)));
+                __mmask16 keep = _mm512_cmp_ps_mask(len, minLen, _CMP_GE_OQ) &
+                                 _mm512_cmp_ps_mask(len, inf, _CMP_LT_OQ);
+
+                _mm512_store_ps(normals[0], _mm512_mask_blend_ps(keep, _mm512_div_ps(cx, area), _mm512_div_ps(nx, len)));
+                _mm512_store_ps(normals[1], _mm512_mask_blend_ps(keep, _mm512_div_ps(cy, area), _mm512_div_ps(ny, len)));
+                _mm512_store_ps(normals[2], _mm512_mask_blend_ps(keep, _mm512_div_ps(cz, area), _mm512_div_ps(nz, len)));
+
+                emitBatch<W>(batch, static_cast<unsigned>(valid), normals, out, rejected,
+                                        firstIndex + static_cast<uint32_t>(i));
+            }
+
+            processScalar(records + i * RECORD_SIZE, count - i, out, rejected,
+                          firstIndex + static_cast<uint32_t>(i));
+            return out.written - start;
+        }
+#pragma GCC diagnostic pop
+#endif
+    }
+
+    TriangleKernel::Isa TriangleKernel::detectIsa() {
+#ifdef STL2GLB_KERNEL_X86
+        static const Isa isa = []() {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+            if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+            if (__builtin_cpu_supports("sse4.2")) return Isa::SSE42;
+            return Isa::Scalar;
+        }();
+        return isa;
+#else
+        return Isa::Scalar;
+#endif
+    }
+
+    const char* TriangleKernel::isaName(Isa isa) {
+        switch (isa) {
+            case Isa::SSE42: return "SSE4.2";
+            case Isa::AVX2: return "AVX2";
+            case Isa::AVX512: return "AVX-512";
+            default: return "scalar";
+        }
+    }
+
+    size_t TriangleKernel::process(const uint8_t* records, size_t count, float* positions, float* normals,
+                                   std::vector<uint32_t>& rejected, uint32_t firstIndex) {
+        return process(detectIsa(), records, count, positions, normals, rejected, firstIndex);
+    }
+
+    size_t TriangleKernel::process(Isa isa, const uint8_t* records, size_t count, float* positions, float* normals,
+                                   std::vector<uint32_t>& rejected, uint32_t firstIndex) {
+        Output out{positions, normals};
+        switch (isa) {
+#ifdef STL2GLB_KERNEL_X86
+            case Isa::AVX512: return processAVX512(records, count, out, rejected, firstIndex);
+            case Isa::AVX2: return processAVX2(records, count, out, rejected, firstIndex);
+            case Isa::SSE42: return processSSE42(records, count, out, rejected, firstIndex);
+#endif
+            default: return processScalar(records, count, out, rejected, firstIndex);
+        }
+    }
+
+} // namespace stl2glb
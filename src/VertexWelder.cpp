@@ -0,0 +1,360 @@
+#include "stl2glb/VertexWelder.hpp"
+#include "stl2glb/Parallel.hpp"
+#include "stl2glb/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace stl2glb {
+
+    namespace {
+        // Sotto questa soglia (circa 1M triangoli) la tabella hash su un thread è più veloce
+        constexpr size_t PARALLEL_MIN_CORNERS = 3 * 1024 * 1024;
+        constexpr size_t MIN_CORNERS_PER_THREAD = 512 * 1024;
+
+        constexpr int RADIX_BITS = 16;
+        constexpr size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+        constexpr int RADIX_PASSES = 96 / RADIX_BITS;
+
+        // Chiave a 96 bit della posizione e angolo di provenienza (16 byte)
+        struct CornerKey {
+            uint32_t key[3];
+            uint32_t corner;
+        };
+
+        inline uint32_t keyBits(float v) {
+            // -0.0f == 0.0f: stessa chiave, come in VertexWeldTable
+            if (v == 0.0f) v = 0.0f;
+            uint32_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            return bits;
+        }
+
+        inline uint32_t radixDigit(const CornerKey& k, int pass) {
+            return (k.key[pass / 2] >> ((pass % 2) * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+        }
+
+        inline bool sameKey(const CornerKey& a, const CornerKey& b) {
+            return a.key[0] == b.key[0] && a.key[1] == b.key[1] && a.key[2] == b.key[2];
+        }
+
+        void computeBounds(const float* v, size_t count, std::array<float, 3>& minBounds,
+                           std::array<float, 3>& maxBounds) {
+            minBounds = {std::numeric_limits<float>::max(),
+                         std::numeric_limits<float>::max(),
+                         std::numeric_limits<float>::max()};
+            maxBounds = {std::numeric_limits<float>::lowest(),
+                         std::numeric_limits<float>::lowest(),
+                         std::numeric_limits<float>::lowest()};
+
+            for (size_t i = 0; i < count; ++i) {
+                for (int k = 0; k < 3; ++k) {
+                    minBounds[k] = std::min(minBounds[k], v[i * 3 + k]);
+                    maxBounds[k] = std::max(maxBounds[k], v[i * 3 + k]);
+                }
+            }
+        }
+
+        void computeBounds(IndexedMesh& out) {
+            computeBounds(out.vertices.data(), out.vertexCount(), out.minBounds, out.maxBounds);
+        }
+
+        // Radix sort LSD stabile: ogni thread fa l'istogramma del proprio blocco e lo
+        // scatter avviene in ordine bucket-major/thread-minor, quindi a parità di chiave
+        // gli angoli restano in ordine crescente
+        void radixSort(AlignedBuffer<CornerKey>& data, unsigned numThreads) {
+            const size_t n = data.size();
+            AlignedBuffer<CornerKey> scratch(n);
+            std::vector<std::vector<size_t>> histograms(numThreads, std::vector<size_t>(RADIX_BUCKETS));
+
+            CornerKey* src = data.data();
+            CornerKey* dst = scratch.data();
+
+            for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+                Parallel::run(numThreads, [&](size_t t) {
+                    auto& hist = histograms[t];
+                    std::fill(hist.begin(), hist.end(), 0);
+                    auto range = Parallel::blockRange(t, numThreads, n);
+                    for (size_t i = range.first; i < range.second; ++i) {
+                        ++hist[radixDigit(src[i], pass)];
+                    }
+                });
+
+                // Se tutte le chiavi hanno la stessa cifra il passaggio non cambia l'ordine
+                size_t firstBucketCount = 0;
+                uint32_t firstBucket = radixDigit(src[0], pass);
+                for (const auto& hist : histograms) {
+                    firstBucketCount += hist[firstBucket];
+                }
+                if (firstBucketCount == n) continue;
+
+                size_t offset = 0;
+                for (size_t b = 0; b < RADIX_BUCKETS; ++b) {
+                    for (auto& hist : histograms) {
+                        size_t c = hist[b];
+                        hist[b] = offset;
+                        offset += c;
+                    }
+                }
+
+                Parallel::run(numThreads, [&](size_t t) {
+                    auto& hist = histograms[t];
+                    auto range = Parallel::blockRange(t, numThreads, n);
+                    for (size_t i = range.first; i < range.second; ++i) {
+                        dst[hist[radixDigit(src[i], pass)]++] = src[i];
+                    }
+                });
+
+                std::swap(src, dst);
+            }
+
+            if (src != data.data()) {
+                data = std::move(scratch);
+            }
+        }
+
+        // Somma prefissa inclusiva in due fasi: totali per blocco, poi scansione con offset
+        void inclusiveScan(uint32_t* values, size_t n, unsigned numThreads) {
+            std::vector<uint32_t> blockOffsets(numThreads, 0);
+
+            Parallel::run(numThreads, [&](size_t t) {
+                auto range = Parallel::blockRange(t, numThreads, n);
+                uint32_t sum = 0;
+                for (size_t i = range.first; i < range.second; ++i) {
+                    sum += values[i];
+                }
+                blockOffsets[t] = sum;
+            });
+
+            uint32_t running = 0;
+            for (auto& offset : blockOffsets) {
+                uint32_t sum = offset;
+                offset = running;
+                running += sum;
+            }
+
+            Parallel::run(numThreads, [&](size_t t) {
+                auto range = Parallel::blockRange(t, numThreads, n);
+                uint32_t sum = blockOffsets[t];
+                for (size_t i = range.first; i < range.second; ++i) {
+                    sum += values[i];
+                    values[i] = sum;
+                }
+            });
+        }
+    }
+
+    IndexedMesh VertexWelder::weld(const Mesh& mesh, const ConversionOptions& options) {
+        if (options.weldMode == WeldMode::Tolerance) {
+            return weldWithTolerance(mesh, options.weldTolerance);
+        }
+
+        const size_t corners = mesh.triangleCount() * 3;
+        unsigned numThreads = Parallel::threadCount(corners, MIN_CORNERS_PER_THREAD);
+
+        if (corners >= PARALLEL_MIN_CORNERS && numThreads > 1) {
+            return weldParallel(mesh, numThreads);
+        }
+        return weldSequential(mesh);
+    }
+
+    IndexedMesh VertexWelder::weldSequential(const Mesh& mesh) {
+        WeldAccumulator accumulator(mesh.triangleCount(), mesh.hasNormals());
+        accumulator.addTriangles(mesh.positions(), mesh.normals(), mesh.triangleCount());
+        return accumulator.finish();
+    }
+
+    IndexedMesh VertexWelder::weldParallel(const Mesh& mesh, unsigned numThreads) {
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        IndexedMesh out;
+        const size_t corners = mesh.triangleCount() * 3;
+        const float* positions = mesh.positions();
+        const float* faceNormals = mesh.normals();
+
+        if (corners == 0) {
+            computeBounds(out);
+            return out;
+        }
+
+        Logger::info("Parallel vertex welding on " + std::to_string(numThreads) + " threads");
+
+        // 1. Chiavi di posizione per ogni angolo, in ordine di angolo
+        AlignedBuffer<CornerKey> keys(corners);
+        Parallel::run(numThreads, [&](size_t t) {
+            auto range = Parallel::blockRange(t, numThreads, corners);
+            for (size_t c = range.first; c < range.second; ++c) {
+                const float* p = positions + c * 3;
+                keys[c] = CornerKey{{keyBits(p[0]), keyBits(p[1]), keyBits(p[2])}, static_cast<uint32_t>(c)};
+            }
+        });
+
+        // 2. Ordinamento stabile: gli angoli con la stessa posizione diventano contigui,
+        //    il primo di ogni gruppo è la prima occorrenza nel file
+        radixSort(keys, numThreads);
+
+        // 3. Flag di prima occorrenza indicizzato per angolo, poi somma prefissa:
+        //    firstCount[c] = numero di vertici unici introdotti dagli angoli [0, c]
+        AlignedBuffer<uint32_t> firstCount(corners);
+        Parallel::run(numThreads, [&](size_t t) {
+            auto range = Parallel::blockRange(t, numThreads, corners);
+            for (size_t i = range.first; i < range.second; ++i) {
+                bool leader = i == 0 || !sameKey(keys[i], keys[i - 1]);
+                firstCount[keys[i].corner] = leader ? 1u : 0u;
+            }
+        });
+        inclusiveScan(firstCount.data(), corners, numThreads);
+
+        const size_t vertexCount = firstCount[corners - 1];
+
+        // 4. Ogni angolo prende l'id del primo angolo del proprio gruppo
+        out.indices.resize(corners);
+        Parallel::run(numThreads, [&](size_t t) {
+            auto range = Parallel::blockRange(t, numThreads, corners);
+            if (range.first == range.second) return;
+
+            // Il gruppo può essere iniziato nel blocco precedente
+            size_t groupStart = range.first;
+            while (groupStart > 0 && sameKey(keys[groupStart], keys[groupStart - 1])) {
+                --groupStart;
+            }
+            uint32_t vertexId = firstCount[keys[groupStart].corner] - 1;
+
+            for (size_t i = range.first; i < range.second; ++i) {
+                if (i > groupStart && !sameKey(keys[i], keys[i - 1])) {
+                    vertexId = firstCount[keys[i].corner] - 1;
+                }
+                out.indices[keys[i].corner] = vertexId;
+            }
+        });
+        keys.release();
+
+        // 5. Scatter di posizioni e normali dei vertici unici nel loro ordine di prima occorrenza
+        out.vertices.resize(vertexCount * 3);
+        if (faceNormals) {
+            out.normals.resize(vertexCount * 3);
+        }
+        Parallel::run(numThreads, [&](size_t t) {
+            auto range = Parallel::blockRange(t, numThreads, corners);
+            for (size_t c = range.first; c < range.second; ++c) {
+                uint32_t before = c > 0 ? firstCount[c - 1] : 0;
+                if (firstCount[c] == before) continue;
+
+                std::memcpy(out.vertices.data() + static_cast<size_t>(before) * 3, positions + c * 3,
+                            3 * sizeof(float));
+                if (faceNormals) {
+                    std::memcpy(out.normals.data() + static_cast<size_t>(before) * 3,
+                                faceNormals + (c / 3) * Mesh::FLOATS_PER_NORMAL, 3 * sizeof(float));
+                }
+            }
+        });
+
+        computeBounds(out);
+        return out;
+    }
+
+    IndexedMesh VertexWelder::weldWithTolerance(const Mesh& mesh, float tolerance) {
+        const size_t triangles = mesh.triangleCount();
+        if (triangles == 0) {
+            IndexedMesh out;
+            computeBounds(out);
+            return out;
+        }
+
+        // La griglia è dimensionata sul bounding box dell'input
+        std::array<float, 3> minBounds, maxBounds;
+        computeBounds(mesh.positions(), triangles * 3, minBounds, maxBounds);
+
+        if (!(tolerance > 0.0f)) {
+            float dx = maxBounds[0] - minBounds[0];
+            float dy = maxBounds[1] - minBounds[1];
+            float dz = maxBounds[2] - minBounds[2];
+            tolerance = std::sqrt(dx * dx + dy * dy + dz * dz) * ConversionOptions::DEFAULT_RELATIVE_TOLERANCE;
+            // Mesh ridotta a un punto: ogni tolleranza positiva va bene
+            if (!(tolerance > 0.0f)) {
+                tolerance = std::numeric_limits<float>::min();
+            }
+        }
+
+        WeldAccumulator accumulator(triangles, mesh.hasNormals(), minBounds, maxBounds, tolerance);
+        accumulator.addTriangles(mesh.positions(), mesh.normals(), triangles);
+        return accumulator.finish();
+    }
+
+    // In una mesh chiusa i vertici unici sono circa la metà dei triangoli,
+    // il numero di triangoli basta come stima
+    WeldAccumulator::WeldAccumulator(size_t expectedTriangles, bool withNormals)
+            : withNormals(withNormals) {
+        exactTable.emplace(expectedTriangles);
+        out.vertices.reserve(expectedTriangles * 3 / 2);
+        if (withNormals) {
+            out.normals.reserve(expectedTriangles * 3 / 2);
+        }
+        out.indices.reserve(expectedTriangles * 3);
+    }
+
+    WeldAccumulator::WeldAccumulator(size_t expectedTriangles, bool withNormals,
+                                     const std::array<float, 3>& minBounds,
+                                     const std::array<float, 3>& maxBounds, float tolerance)
+            : withNormals(withNormals), tolerance(tolerance) {
+        grid.emplace(minBounds, maxBounds, tolerance, expectedTriangles);
+        out.vertices.reserve(expectedTriangles * 3 / 2);
+        if (withNormals) {
+            out.normals.reserve(expectedTriangles * 3 / 2);
+        }
+        out.indices.reserve(expectedTriangles * 3);
+    }
+
+    void WeldAccumulator::addTriangles(const float* positions, const float* normals, size_t count) {
+        for (size_t t = 0; t < count; ++t) {
+            const float* tri = positions + t * Mesh::FLOATS_PER_TRIANGLE;
+            uint32_t triIndices[3];
+
+            for (int c = 0; c < 3; ++c) {
+                const float* vert = tri + c * 3;
+
+                // Indice del vertice esistente, oppure il prossimo libero se è nuovo
+                uint32_t nextIndex = static_cast<uint32_t>(out.vertexCount());
+                uint32_t index = exactTable ? exactTable->findOrInsert(vert, nextIndex)
+                                            : grid->findOrInsert(vert, nextIndex);
+                if (index == nextIndex) {
+                    out.vertices.append(vert, 3);
+
+                    // La normale del vertice è quella del triangolo che lo introduce
+                    if (withNormals) {
+                        out.normals.append(normals + t * Mesh::FLOATS_PER_NORMAL, 3);
+                    }
+                }
+
+                triIndices[c] = index;
+            }
+
+            // Triangolo collassato dalla saldatura con tolleranza: non contribuisce alla superficie
+            if (grid && (triIndices[0] == triIndices[1] || triIndices[1] == triIndices[2] ||
+                         triIndices[0] == triIndices[2])) {
+                ++degenerate;
+                continue;
+            }
+            out.indices.append(triIndices, 3);
+        }
+    }
+
+    IndexedMesh WeldAccumulator::finish() {
+        if (grid) {
+            char toleranceText[32];
+            std::snprintf(toleranceText, sizeof(toleranceText), "%g", tolerance);
+            Logger::info("Tolerance welding: " + std::to_string(out.vertexCount()) + " vertices, tolerance " +
+                         toleranceText + ", " + std::to_string(degenerate) + " degenerate triangles removed");
+        }
+
+        computeBounds(out);
+        return std::move(out);
+    }
+
+} // namespace stl2glb